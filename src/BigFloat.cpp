@@ -0,0 +1,425 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "BigFloat.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace fractalnova {
+
+BigFloat::BigFloat(const unsigned fractionLimbs): limbs(fractionLimbs + 1, 0)
+{
+}
+
+BigFloat::BigFloat(const double value, const unsigned fractionLimbs): limbs(fractionLimbs + 1, 0)
+{
+    if (!std::isfinite(value) || std::fabs(value) >= 4294967296.0) {
+        throw std::runtime_error("BigFloat value out of range");
+    }
+
+    negative = value < 0.0;
+
+    double magnitude = std::fabs(value);
+
+    // Peel off 32 bits at a time, starting from the integer part. Exact for doubles.
+    for (std::size_t i = limbs.size(); i-- > 0 && magnitude > 0.0;) {
+        const double limb = std::floor(magnitude);
+        limbs[i] = static_cast<std::uint32_t>(limb);
+        magnitude = (magnitude - limb) * 4294967296.0;
+    }
+}
+
+BigFloat::BigFloat(const FloatExp& value, const unsigned fractionLimbs): BigFloat(value.Mantissa(), fractionLimbs)
+{
+    // The mantissa is below one, apply the exponent 16 bits at a time
+    std::int64_t exponent = value.Exponent();
+
+    while (exponent < 0) {
+        const std::int64_t step = std::min<std::int64_t>(16, -exponent);
+        DivideSmall(1u << step);
+        exponent += step;
+    }
+
+    while (exponent > 0) {
+        const std::int64_t step = std::min<std::int64_t>(16, exponent);
+        MultiplySmall(1u << step);
+        exponent -= step;
+    }
+
+    if (IsZero()) {
+        negative = false;
+    }
+}
+
+unsigned BigFloat::LimbsForBits(const unsigned bits)
+{
+    return (bits + 31) / 32;
+}
+
+BigFloat BigFloat::WithLimbs(const unsigned fractionLimbs) const
+{
+    BigFloat result { fractionLimbs };
+    result.negative = negative;
+
+    const std::size_t from = limbs.size();
+    const std::size_t to = result.limbs.size();
+
+    // Align the integer parts
+    for (std::size_t i = 0; i < std::min(from, to); i++) {
+        result.limbs[to - 1 - i] = limbs[from - 1 - i];
+    }
+
+    return result;
+}
+
+BigFloat BigFloat::Parse(const std::string& text, const unsigned fractionLimbs)
+{
+    std::size_t pos = 0;
+    bool negative = false;
+
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        pos++;
+    }
+
+    std::string integerDigits;
+    std::string fractionDigits;
+
+    while (pos < text.size() && isdigit(static_cast<unsigned char>(text[pos]))) {
+        integerDigits += text[pos++];
+    }
+
+    if (pos < text.size() && text[pos] == '.') {
+        pos++;
+        while (pos < text.size() && isdigit(static_cast<unsigned char>(text[pos]))) {
+            fractionDigits += text[pos++];
+        }
+    }
+
+    long exponent = 0;
+
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        exponent = strtol(text.c_str() + pos + 1, nullptr, 10);
+        pos = text.size();
+    }
+
+    if (pos != text.size() || (integerDigits.empty() && fractionDigits.empty())) {
+        throw std::runtime_error("Invalid number '" + text + "'");
+    }
+
+    // Move the decimal point according to the exponent
+    std::string digits = integerDigits + fractionDigits;
+    long pointPosition = static_cast<long>(integerDigits.size()) + exponent;
+
+    if (pointPosition < 0) {
+        digits.insert(0, static_cast<std::size_t>(-pointPosition), '0');
+        pointPosition = 0;
+    } else if (pointPosition > static_cast<long>(digits.size())) {
+        digits.append(static_cast<std::size_t>(pointPosition) - digits.size(), '0');
+    }
+
+    const std::string whole = digits.substr(0, static_cast<std::size_t>(pointPosition));
+    const std::string fraction = digits.substr(static_cast<std::size_t>(pointPosition));
+
+    // Horner from the least significant digit: x = (x + d) / 10
+    BigFloat result { fractionLimbs };
+
+    for (auto it = fraction.rbegin(); it != fraction.rend(); ++it) {
+        result.limbs.back() += static_cast<std::uint32_t>(*it - '0');
+        result.DivideSmall(10);
+    }
+
+    std::uint64_t integerPart = 0;
+
+    for (const char c: whole) {
+        integerPart = integerPart * 10 + static_cast<std::uint64_t>(c - '0');
+
+        if (integerPart > 0xffffffffu) {
+            throw std::runtime_error("BigFloat value out of range");
+        }
+    }
+
+    result.limbs.back() = static_cast<std::uint32_t>(integerPart);
+    result.negative = negative && !result.IsZero();
+
+    return result;
+}
+
+double BigFloat::ToDouble() const
+{
+    double result = 0.0;
+
+    // Three limbs cover the 53 bits of a double
+    const std::size_t count = limbs.size();
+    double scale = 1.0;
+
+    for (std::size_t i = count; i-- > 0;) {
+        if (limbs[i] != 0) {
+            for (std::size_t j = i + 1; j-- > 0 && j + 3 > i;) {
+                result += static_cast<double>(limbs[j]) * std::ldexp(scale, -32 * static_cast<int>(count - 1 - j));
+            }
+            break;
+        }
+    }
+
+    return negative ? -result : result;
+}
+
+FloatExp BigFloat::ToFloatExp() const
+{
+    const std::size_t count = limbs.size();
+
+    for (std::size_t i = count; i-- > 0;) {
+        if (limbs[i] != 0) {
+            double mantissa = 0.0;
+
+            for (std::size_t j = i + 1; j-- > 0 && j + 3 > i;) {
+                mantissa += std::ldexp(static_cast<double>(limbs[j]), -32 * static_cast<int>(i - j));
+            }
+
+            const std::int64_t exponent = 32 * (static_cast<std::int64_t>(i) - static_cast<std::int64_t>(count - 1));
+
+            return FloatExp { negative ? -mantissa : mantissa, exponent };
+        }
+    }
+
+    return FloatExp {};
+}
+
+void BigFloat::Split(double* parts, const unsigned count) const
+{
+    BigFloat rest = *this;
+
+    for (unsigned i = 0; i < count; i++) {
+        parts[i] = rest.ToDouble();
+        rest -= BigFloat { parts[i], FractionLimbs() };
+    }
+}
+
+std::string BigFloat::ToString(const unsigned digits) const
+{
+    std::string text = negative ? "-" : "";
+    text += std::to_string(limbs.back());
+    text += '.';
+
+    BigFloat fraction = *this;
+    fraction.negative = false;
+    fraction.limbs.back() = 0;
+
+    for (unsigned i = 0; i < digits; i++) {
+        fraction.MultiplySmall(10);
+        text += static_cast<char>('0' + fraction.limbs.back());
+        fraction.limbs.back() = 0;
+    }
+
+    return text;
+}
+
+bool BigFloat::IsZero() const
+{
+    return std::all_of(limbs.begin(), limbs.end(), [](const std::uint32_t limb) { return limb == 0; });
+}
+
+int BigFloat::CompareMagnitude(const Limbs& a, const Limbs& b)
+{
+    for (std::size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+void BigFloat::AddMagnitude(Limbs& a, const Limbs& b)
+{
+    std::uint64_t carry = 0;
+
+    for (std::size_t i = 0; i < a.size(); i++) {
+        const std::uint64_t sum = static_cast<std::uint64_t>(a[i]) + b[i] + carry;
+        a[i] = static_cast<std::uint32_t>(sum);
+        carry = sum >> 32;
+    }
+}
+
+// a -= b, requires |a| >= |b|
+void BigFloat::SubMagnitude(Limbs& a, const Limbs& b)
+{
+    std::int64_t borrow = 0;
+
+    for (std::size_t i = 0; i < a.size(); i++) {
+        std::int64_t diff = static_cast<std::int64_t>(a[i]) - b[i] - borrow;
+        borrow = diff < 0 ? 1 : 0;
+        if (diff < 0) {
+            diff += 4294967296LL;
+        }
+        a[i] = static_cast<std::uint32_t>(diff);
+    }
+}
+
+BigFloat BigFloat::AddSigned(const BigFloat& a, const BigFloat& b, const bool negateB)
+{
+    if (a.limbs.size() != b.limbs.size()) {
+        const unsigned limbCount = std::max(a.FractionLimbs(), b.FractionLimbs());
+        return AddSigned(a.WithLimbs(limbCount), b.WithLimbs(limbCount), negateB);
+    }
+
+    const bool bNegative = b.negative != negateB;
+
+    BigFloat result = a;
+
+    if (a.negative == bNegative) {
+        AddMagnitude(result.limbs, b.limbs);
+    } else if (CompareMagnitude(a.limbs, b.limbs) >= 0) {
+        SubMagnitude(result.limbs, b.limbs);
+    } else {
+        result.limbs = b.limbs;
+        SubMagnitude(result.limbs, a.limbs);
+        result.negative = bNegative;
+    }
+
+    if (result.IsZero()) {
+        result.negative = false;
+    }
+
+    return result;
+}
+
+BigFloat BigFloat::operator+(const BigFloat& other) const
+{
+    return AddSigned(*this, other, false);
+}
+
+BigFloat BigFloat::operator-(const BigFloat& other) const
+{
+    return AddSigned(*this, other, true);
+}
+
+BigFloat BigFloat::operator-() const
+{
+    BigFloat result = *this;
+    result.negative = !negative && !IsZero();
+    return result;
+}
+
+bool BigFloat::operator==(const BigFloat& other) const
+{
+    return negative == other.negative && limbs == other.limbs;
+}
+
+BigFloat BigFloat::operator*(const BigFloat& other) const
+{
+    if (limbs.size() != other.limbs.size()) {
+        const unsigned limbCount = std::max(FractionLimbs(), other.FractionLimbs());
+        return WithLimbs(limbCount) * other.WithLimbs(limbCount);
+    }
+
+    const std::size_t n = limbs.size();
+    const std::size_t fractionLimbs = n - 1;
+
+    // Full product, then drop the extra fraction limbs
+    Limbs product(2 * n, 0);
+
+    for (std::size_t i = 0; i < n; i++) {
+        if (limbs[i] == 0) {
+            continue;
+        }
+
+        std::uint64_t carry = 0;
+
+        for (std::size_t j = 0; j < n; j++) {
+            const std::uint64_t t = static_cast<std::uint64_t>(limbs[i]) * other.limbs[j] + product[i + j] + carry;
+            product[i + j] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+
+        product[i + n] = static_cast<std::uint32_t>(carry);
+    }
+
+    BigFloat result { static_cast<unsigned>(fractionLimbs) };
+    std::copy(product.begin() + static_cast<std::ptrdiff_t>(fractionLimbs),
+              product.begin() + static_cast<std::ptrdiff_t>(fractionLimbs + n),
+              result.limbs.begin());
+
+    result.negative = (negative != other.negative) && !result.IsZero();
+
+    return result;
+}
+
+BigFloat BigFloat::Twice() const
+{
+    BigFloat result = *this;
+    AddMagnitude(result.limbs, limbs);
+    return result;
+}
+
+BigFloat BigFloat::Square() const
+{
+    return *this * *this;
+}
+
+BigFloat BigFloat::Reciprocal() const
+{
+    const double value = ToDouble();
+
+    if (value == 0.0) {
+        throw std::runtime_error("BigFloat reciprocal of zero");
+    }
+
+    const unsigned fractionLimbs = FractionLimbs();
+    const BigFloat two { 2.0, fractionLimbs };
+
+    // Newton iteration r = r * (2 - x * r) doubles the correct bits every round
+    BigFloat r { 1.0 / value, fractionLimbs };
+
+    for (unsigned bits = 50; bits < 32 * fractionLimbs + 32; bits *= 2) {
+        r = r * (two - *this * r);
+    }
+
+    return r;
+}
+
+void BigFloat::DivideSmall(const std::uint32_t divisor)
+{
+    std::uint64_t remainder = 0;
+
+    for (std::size_t i = limbs.size(); i-- > 0;) {
+        const std::uint64_t current = (remainder << 32) | limbs[i];
+        limbs[i] = static_cast<std::uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+}
+
+void BigFloat::MultiplySmall(const std::uint32_t factor)
+{
+    std::uint64_t carry = 0;
+
+    for (auto& limb: limbs) {
+        const std::uint64_t t = static_cast<std::uint64_t>(limb) * factor + carry;
+        limb = static_cast<std::uint32_t>(t);
+        carry = t >> 32;
+    }
+}
+
+} // fractalnova
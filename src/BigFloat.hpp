@@ -0,0 +1,90 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "FloatExp.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fractalnova {
+
+// Signed fixed-point number with a 32-bit integer part and a configurable
+// number of 32-bit fraction limbs. Enough for Mandelbrot and Julia orbits,
+// which stay small until they escape.
+class BigFloat
+{
+public:
+    static constexpr unsigned defaultLimbs { 4 };
+
+    explicit BigFloat(unsigned fractionLimbs = defaultLimbs);
+    BigFloat(double value, unsigned fractionLimbs);
+    BigFloat(const FloatExp& value, unsigned fractionLimbs);
+
+    static BigFloat Parse(const std::string& text, unsigned fractionLimbs);
+    static unsigned LimbsForBits(unsigned bits);
+
+    unsigned FractionLimbs() const { return static_cast<unsigned>(limbs.size()) - 1; }
+    BigFloat WithLimbs(unsigned fractionLimbs) const;
+
+    double ToDouble() const;
+    // Keeps the exponent of tiny values, which ToDouble() flushes to zero
+    FloatExp ToFloatExp() const;
+    // Sum of doubles, largest first, for double-double style arithmetic
+    void Split(double* parts, unsigned count) const;
+    std::string ToString(unsigned digits) const;
+    bool IsZero() const;
+
+    BigFloat operator+(const BigFloat& other) const;
+    BigFloat operator-(const BigFloat& other) const;
+    BigFloat operator*(const BigFloat& other) const;
+    BigFloat operator-() const;
+
+    // Exact, the number of limbs must match too
+    bool operator==(const BigFloat& other) const;
+    bool operator!=(const BigFloat& other) const { return !(*this == other); }
+
+    BigFloat& operator+=(const BigFloat& other) { return *this = *this + other; }
+    BigFloat& operator-=(const BigFloat& other) { return *this = *this - other; }
+
+    BigFloat Twice() const;
+    BigFloat Square() const;
+    // Within the fixed-point range, so the value must not be tiny
+    BigFloat Reciprocal() const;
+
+private:
+    // Little-endian magnitude, the last limb is the integer part
+    using Limbs = std::vector<std::uint32_t>;
+
+    static int CompareMagnitude(const Limbs& a, const Limbs& b);
+    static void AddMagnitude(Limbs& a, const Limbs& b);
+    static void SubMagnitude(Limbs& a, const Limbs& b);
+    static BigFloat AddSigned(const BigFloat& a, const BigFloat& b, bool negateB);
+
+    void DivideSmall(std::uint32_t divisor);
+    void MultiplySmall(std::uint32_t factor);
+
+    Limbs limbs;
+    bool negative { false };
+};
+
+} // fractalnova
@@ -0,0 +1,150 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "BlaTable.hpp"
+#include "Perturbation.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace fractalnova {
+
+// Same bailout as the shaders, |z| <= 2
+static constexpr double escapeRadius { 2.0 };
+
+static BlaStep Merge(const BlaStep& x, const BlaStep& y, const double middle, const double maxDeltaC)
+{
+    BlaStep step;
+
+    // y(x(delta)) = Ay Ax delta + (Ay Bx + By) delta c
+    step.ax = y.ax * x.ax - y.ay * x.ay;
+    step.ay = y.ax * x.ay + y.ay * x.ax;
+    step.bx = y.ax * x.bx - y.ay * x.by + y.bx;
+    step.by = y.ax * x.by + y.ay * x.bx + y.by;
+
+    // Delta entering y must stay within its radius. std::max drops a NaN from overflowed products.
+    const double ax = std::hypot(x.ax, x.ay);
+    const double bx = std::hypot(x.bx, x.by);
+
+    step.radius = std::min(x.radius, std::max(0.0, (y.radius - bx * maxDeltaC) / ax));
+    step.sum = x.sum + static_cast<float>(std::exp(-middle)) + y.sum;
+    step.length = x.length + y.length;
+
+    return step;
+}
+
+BlaTable::BlaTable(const ReferenceOrbit& reference, const bool julia, const double maxDeltaC, const double epsilon)
+{
+    const std::size_t size = reference.Size();
+
+    if (size < 3) {
+        return;
+    }
+
+    // Delta c below double range still counts as the smallest double so that the
+    // radii stay on the safe side
+    const double deltaC = std::max(maxDeltaC, DBL_MIN);
+
+    // Step at index j needs Z_j and produces index j + 1
+    std::vector<BlaStep> steps;
+    steps.reserve(size - 2);
+
+    for (std::size_t j = 1; j + 1 < size; j++) {
+        const double zx = reference.Zx(j);
+        const double zy = reference.Zy(j);
+        const double z = std::hypot(zx, zy);
+
+        BlaStep step;
+        step.ax = 2.0 * zx;
+        step.ay = 2.0 * zy;
+        step.bx = julia ? 0.0 : 1.0;
+        step.by = 0.0;
+        // |delta^2| < epsilon |2 Z delta|, and Z + delta must not escape
+        step.radius = std::max(0.0, std::min(epsilon * 2.0 * z, escapeRadius - z));
+        step.sum = 0.0f;
+        step.length = 1;
+
+        steps.push_back(step);
+    }
+
+    levels.push_back(std::move(steps));
+
+    while (levels.back().size() >= 2) {
+        const std::vector<BlaStep>& lower = levels.back();
+        std::vector<BlaStep> upper;
+        upper.reserve(lower.size() / 2);
+
+        for (std::size_t i = 0; i + 1 < lower.size(); i += 2) {
+            // Index where the second half starts, its first Z has not been summed yet
+            const std::size_t middle = 1 + (i + 1) * lower[i].length;
+            const double z = std::hypot(reference.Zx(middle), reference.Zy(middle));
+
+            upper.push_back(Merge(lower[i], lower[i + 1], z, deltaC));
+        }
+
+        levels.push_back(std::move(upper));
+    }
+
+    if (levels.size() >= 2) {
+        for (const BlaStep& step: levels[1]) {
+            maxRadius = std::max(maxRadius, step.radius);
+        }
+    }
+
+    logging::Detail("BLA table of %u levels", Levels());
+}
+
+const BlaStep* BlaTable::Find(const std::size_t m, const double magnitude, const int limit) const
+{
+    if (m == 0) {
+        return nullptr;
+    }
+
+    const std::size_t i = m - 1;
+    const BlaStep* found = nullptr;
+
+    // Merging never grows the radius, so climb while the longer step at m is
+    // still valid and stop at the first one that is not
+    for (std::size_t level = 1; level < levels.size(); level++) {
+        if ((i & ((std::size_t { 1 } << level) - 1)) != 0) {
+            break;
+        }
+
+        const std::size_t index = i >> level;
+
+        if (index >= levels[level].size()) {
+            break;
+        }
+
+        const BlaStep& step = levels[level][index];
+
+        if (magnitude >= step.radius || static_cast<int>(step.length) > limit) {
+            break;
+        }
+
+        found = &step;
+    }
+
+    return found;
+}
+
+} // fractalnova
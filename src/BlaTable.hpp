@@ -0,0 +1,73 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fractalnova {
+
+class ReferenceOrbit;
+
+// Several iterations of delta' = 2 Z delta + delta^2 + delta c collapsed into
+// delta' = A delta + B delta c, valid while delta is small compared to Z
+struct BlaStep
+{
+    double ax;
+    double ay;
+    double bx;
+    double by;
+    double radius; // Valid while |delta| < radius
+    float sum; // Julia colouring of the skipped iterations, except the last one
+    std::uint32_t length;
+};
+
+// Bivariate linear approximation of a reference orbit. Single steps are merged
+// pairwise into a binary table so that a pixel can skip up to thousands of
+// iterations with one complex multiply-add.
+class BlaTable
+{
+public:
+    // Relative size of the dropped delta^2 term. Smaller is more accurate but skips
+    // less. Larger values visibly change pixels close to minibrots, where the
+    // rounding error of double precision is about all the orbit can take.
+    static constexpr double defaultEpsilon { 0x1p-53 };
+
+    // maxDeltaC: largest |delta c| of any pixel relative to the reference
+    BlaTable(const ReferenceOrbit& reference, bool julia, double maxDeltaC, double epsilon = defaultEpsilon);
+
+    // Longest step of at least two iterations starting at reference index m that
+    // is valid for |delta| <= magnitude and not longer than limit
+    const BlaStep* Find(std::size_t m, double magnitude, int limit) const;
+
+    // No step is valid for deltas at least this large
+    double MaxRadius() const { return maxRadius; }
+    unsigned Levels() const { return static_cast<unsigned>(levels.size()); }
+
+private:
+    double maxRadius { 0.0 };
+
+    // levels[k][i] covers 2^k iterations starting from reference index 1 + i * 2^k
+    std::vector<std::vector<BlaStep>> levels;
+};
+
+} // fractalnova
@@ -0,0 +1,161 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "BlueNoise.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fractalnova {
+
+static constexpr std::uint32_t size { BlueNoise::size };
+static constexpr std::uint32_t count { size * size };
+// Of the Gaussian that measures how crowded a pixel is
+static constexpr double sigma { 1.5 };
+
+namespace {
+
+// Binary pattern and the Gaussian filtered density of its points at every
+// pixel, wrapping around the edges
+struct Pattern
+{
+    const std::vector<double>& kernel;
+    std::vector<std::uint8_t> points = std::vector<std::uint8_t>(count, 0);
+    std::vector<double> energy = std::vector<double>(count, 0.0);
+
+    void Set(const std::uint32_t index, const bool on)
+    {
+        const std::uint32_t px = index % size;
+        const std::uint32_t py = index / size;
+        const double sign = on ? 1.0 : -1.0;
+
+        points[index] = on ? 1 : 0;
+
+        for (std::uint32_t y = 0; y < size; y++) {
+            const double* row = &kernel[((y + size - py) % size) * size];
+
+            for (std::uint32_t x = 0; x < size; x++) {
+                energy[y * size + x] += sign * row[(x + size - px) % size];
+            }
+        }
+    }
+
+    // Point with the most others around it
+    std::uint32_t TightestCluster() const
+    {
+        std::uint32_t best = 0;
+        double most = -1.0;
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            if (points[i] && energy[i] > most) {
+                most = energy[i];
+                best = i;
+            }
+        }
+
+        return best;
+    }
+
+    // Empty pixel farthest from the points. Once more than half are set, this
+    // is also the tightest cluster of the empty pixels.
+    std::uint32_t LargestVoid() const
+    {
+        std::uint32_t best = 0;
+        double least = HUGE_VAL;
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            if (!points[i] && energy[i] < least) {
+                least = energy[i];
+                best = i;
+            }
+        }
+
+        return best;
+    }
+};
+
+} // anonymous
+
+BlueNoise::BlueNoise(const std::uint32_t seed):
+    values(count)
+{
+    std::vector<double> kernel(count);
+
+    for (std::uint32_t y = 0; y < size; y++) {
+        for (std::uint32_t x = 0; x < size; x++) {
+            const double dx = static_cast<double>(std::min(x, size - x));
+            const double dy = static_cast<double>(std::min(y, size - y));
+
+            kernel[y * size + x] = std::exp(-(dx * dx + dy * dy) / (2.0 * sigma * sigma));
+        }
+    }
+
+    // A tenth of the pixels at random
+    Pattern pattern { kernel };
+    const std::uint32_t initial = count / 10;
+    std::uint32_t state = seed;
+
+    for (std::uint32_t placed = 0; placed < initial;) {
+        state = state * 1664525u + 1013904223u;
+        const std::uint32_t index = (state >> 8) % count;
+
+        if (!pattern.points[index]) {
+            pattern.Set(index, true);
+            placed++;
+        }
+    }
+
+    // Spread them by moving the point of the tightest cluster to the largest
+    // void until it would go back where it was
+    for (std::uint32_t moves = 0; moves < count; moves++) {
+        const std::uint32_t cluster = pattern.TightestCluster();
+        pattern.Set(cluster, false);
+
+        const std::uint32_t gap = pattern.LargestVoid();
+        pattern.Set(gap, true);
+
+        if (gap == cluster) {
+            break;
+        }
+    }
+
+    // The initial points are ranked by taking them away from the tightest
+    // clusters, the rest by filling the largest voids
+    std::vector<std::uint32_t> ranks(count);
+    Pattern removed = pattern;
+
+    for (std::uint32_t rank = initial; rank-- > 0;) {
+        const std::uint32_t index = removed.TightestCluster();
+        removed.Set(index, false);
+        ranks[index] = rank;
+    }
+
+    for (std::uint32_t rank = initial; rank < count; rank++) {
+        const std::uint32_t index = pattern.LargestVoid();
+        pattern.Set(index, true);
+        ranks[index] = rank;
+    }
+
+    for (std::uint32_t i = 0; i < count; i++) {
+        values[i] = (static_cast<float>(ranks[i]) + 0.5f) / static_cast<float>(count);
+    }
+}
+
+} // fractalnova
@@ -0,0 +1,46 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace fractalnova {
+
+// Tileable blue noise made with Ulichney's void-and-cluster method. Every
+// value in [0, 1) appears once per tile and neighbouring values are far apart,
+// so thresholds or jitter taken from it have no low frequency clumps.
+class BlueNoise
+{
+public:
+    static constexpr std::uint32_t size { 32 };
+
+    // Different seeds give unrelated tiles
+    explicit BlueNoise(std::uint32_t seed);
+
+    // Repeats every size pixels in both directions
+    float Value(std::uint32_t x, std::uint32_t y) const { return values[(y % size) * size + x % size]; }
+
+private:
+    std::vector<float> values;
+};
+
+} // fractalnova
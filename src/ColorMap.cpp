@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "ColorMap.hpp"
+#include "EscapeTime.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace fractalnova {
+
+ColorMap::ColorMap(const std::vector<Color>& colors): colors(colors), size(static_cast<float>(colors.size()))
+{
+    logging::Debug("Create ColorMap of %zu colors", colors.size());
+
+    if (colors.empty()) {
+        throw std::runtime_error("Empty color map");
+    }
+}
+
+static std::uint8_t Mix(const std::uint8_t a, const std::uint8_t b, const float f)
+{
+    return static_cast<std::uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * f + 0.5f);
+}
+
+Color ColorMap::Sample(float u) const
+{
+    // Interior pixels may produce NaN (log of a negative number). Map them to the first texel.
+    // Floats this large have no fraction left.
+    if (!(std::fabs(u) < 8388608.0f)) {
+        u = 0.0f;
+    }
+
+    // W3DN_REPEAT. Same as u - floor(u), but floor is a library call on targets
+    // without a rounding instruction and this is the inner loop of colouring.
+    u -= static_cast<float>(static_cast<std::int32_t>(u));
+
+    if (u < 0.0f) {
+        u += 1.0f;
+    }
+
+    // W3DN_LINEAR: blend between the two nearest texel centers. texel is in
+    // [-0.5, size - 0.5], so only the ends wrap.
+    const float texel = u * size - 0.5f;
+    const std::size_t last = colors.size() - 1;
+
+    std::size_t i0;
+    float fraction;
+
+    if (texel < 0.0f) {
+        i0 = last;
+        fraction = texel + 1.0f;
+    } else {
+        i0 = std::min(static_cast<std::size_t>(texel), last);
+        fraction = texel - static_cast<float>(i0);
+    }
+
+    const std::size_t i1 = i0 == last ? 0 : i0 + 1;
+
+    const Color& c0 = colors[i0];
+    const Color& c1 = colors[i1];
+
+    return Color { Mix(c0.r, c1.r, fraction), Mix(c0.g, c1.g, fraction), Mix(c0.b, c1.b, fraction), Mix(c0.a, c1.a, fraction) };
+}
+
+Color ColorMap::Interior(const float period, const float offset) const
+{
+    // Golden ratio steps keep neighbouring periods apart on the palette
+    const Color c = Sample(period * 0.618034f + offset);
+
+    return Color { static_cast<std::uint8_t>(c.r / 4), static_cast<std::uint8_t>(c.g / 4), static_cast<std::uint8_t>(c.b / 4), c.a };
+}
+
+void ColorMap::SampleRow(const float* u, Color* out, const std::size_t count, const float offset, const float skip, const Color skipColor) const
+{
+    for (std::size_t i = 0; i < count; i++) {
+        if (u[i] == skip) {
+            out[i] = skipColor;
+        } else if (IsInterior(u[i])) {
+            out[i] = Interior(InteriorPeriod(u[i]), offset);
+        } else {
+            out[i] = Sample(u[i] + offset);
+        }
+    }
+}
+
+static std::uint8_t Scale(const std::uint8_t a, const float f)
+{
+    return static_cast<std::uint8_t>(static_cast<float>(a) * f + 0.5f);
+}
+
+void ColorMap::ShadeRow(const float* distances, Color* out, const std::size_t count, const float full)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        if (distances[i] > 0.0f && distances[i] < full) {
+            const float f = std::sqrt(distances[i] / full);
+            out[i] = Color { Scale(out[i].r, f), Scale(out[i].g, f), Scale(out[i].b, f), out[i].a };
+        }
+    }
+}
+
+} // fractalnova
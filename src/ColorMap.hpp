@@ -0,0 +1,52 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Palette.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace fractalnova {
+
+// CPU counterpart of the palette Texture: a 1D texture with linear
+// filtering and repeat wrapping, sampled like texture(texSampler, vec2(u, 0.0))
+class ColorMap
+{
+public:
+    explicit ColorMap(const std::vector<Color>& colors);
+
+    Color Sample(float u) const;
+    // Interior pixels found by interior detection, a dark palette colour per period
+    Color Interior(float period, float offset) const;
+    // Sample(u + offset) for a row of coordinates, skipColor where u is skip
+    void SampleRow(const float* u, Color* out, std::size_t count, float offset, float skip, Color skipColor) const;
+    // Darkens the pixels that escaped closer than full pixels to the boundary
+    // of the set, by the square root of their distance. Distance zero is left
+    // as it is.
+    static void ShadeRow(const float* distances, Color* out, std::size_t count, float full);
+
+private:
+    std::vector<Color> colors;
+    float size { 0.0f };
+};
+
+} // fractalnova
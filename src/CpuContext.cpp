@@ -0,0 +1,277 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "CpuContext.hpp"
+#include "CpuRenderer.hpp"
+#include "FrameBuffer.hpp"
+#include "GuiWindow.hpp"
+#include "BackBuffer.hpp"
+#include "Fractal.hpp"
+#include "Profiler.hpp"
+#include "Logger.hpp"
+
+#include <proto/graphics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fractalnova {
+
+CpuContext::CpuContext(const GuiWindow& window, const int iterations, const unsigned threads, const bool interior,
+    const unsigned accumulate):
+    renderer(std::make_unique<CpuRenderer>(threads)),
+    window(window),
+    accumulate(accumulate)
+{
+    logging::Debug("Create CpuContext, %u threads", renderer->Threads());
+
+    view.iterations = iterations;
+    renderer->UseInteriorDetection(interior);
+    // Interior components are where borders are uniform
+    renderer->UseSubdivision(interior);
+    // A new view is shown coarse first. Refining it stops for new input, which
+    // usually changes the view again.
+    renderer->UseProgressive(true);
+    renderer->SetCancelCheck([&window] { return window.InputPending(); });
+
+    Resize();
+
+    UseProgram(EFractal::Mandelbrot);
+    UsePalette(EPalette::Rainbow);
+}
+
+CpuContext::~CpuContext()
+{
+    renderer.reset();
+    backBuffer.reset();
+}
+
+void CpuContext::Resize()
+{
+    width = window.Width();
+    height = window.Height();
+
+    if (!backBuffer ||
+        IGraphics->GetBitMapAttr(backBuffer->Data(), BMA_ACTUALWIDTH) < width ||
+        IGraphics->GetBitMapAttr(backBuffer->Data(), BMA_HEIGHT) < height)
+    {
+        backBuffer = std::make_unique<BackBuffer>(width, height, window.WindowPtr()->RPort->BitMap);
+    }
+
+    ResizeRenderer();
+
+    logging::Debug("Frame %lu * %lu", width, height);
+}
+
+void CpuContext::ResizeRenderer()
+{
+    renderer->Resize((width + divisor - 1) / divisor, (height + divisor - 1) / divisor);
+
+    if (divisor > 1) {
+        enlarged = std::make_unique<FrameBuffer>(width, height);
+    } else {
+        enlarged.reset();
+    }
+
+    panPixels = {};
+    recompute = true;
+}
+
+void CpuContext::Clear() const
+{
+    // Nothing to do, every pixel of the frame is written by the renderer and
+    // the last one is kept for reprojection
+}
+
+void CpuContext::Draw() const
+{
+    PROFILE_ZONE(EStage::Draw);
+
+    if (position.x != 0.0 || position.y != 0.0) {
+        // Accumulate panning like Program::UpdateVertexDBO, but by whole pixels so
+        // that the renderer only has to shift the last frame. The rest is carried
+        // over to the next frame.
+        const double zoom = view.zoom.ToDouble();
+        const double frameWidth = static_cast<double>(renderer->Frame().Width());
+        const double frameHeight = static_cast<double>(renderer->Frame().Height());
+
+        panPixels.x += position.x * zoom * frameWidth / 2.0;
+        panPixels.y += position.y * zoom * frameHeight / 2.0;
+
+        const double dx = std::round(panPixels.x);
+        const double dy = std::round(panPixels.y);
+
+        panPixels.x -= dx;
+        panPixels.y -= dy;
+
+        if (dx != 0.0 || dy != 0.0) {
+            // Enough bits to still move by a pixel at the current zoom
+            const unsigned limbs = BigFloat::LimbsForBits(static_cast<unsigned>(std::max(0.0, view.zoom.Log2())) + 64);
+
+            view.pointX = view.pointX.WithLimbs(limbs) + BigFloat { FloatExp { 2.0 * dx / frameWidth } / view.zoom, limbs };
+            view.pointY = view.pointY.WithLimbs(limbs) + BigFloat { FloatExp { 2.0 * dy / frameHeight } / view.zoom, limbs };
+            recompute = true;
+        }
+    }
+
+    if (recompute) {
+        SetFocus();
+        renderer->Render(view);
+        // Draw again to refine the pixels that were reused from the last frame
+        recompute = renderer->ProvisionalPixels() > 0;
+        recolor = false;
+        accumulating = !recompute && accumulate > 1;
+    } else if (recolor) {
+        // Only the palette changed, colour the values of the last frame again
+        renderer->Colorize();
+        recolor = false;
+        accumulating = accumulate > 1;
+    } else if (accumulating) {
+        // The view stays, every frame adds a jittered sample to each pixel
+        accumulating = renderer->Accumulate() && renderer->AccumulatedSamples() < accumulate;
+    }
+}
+
+void CpuContext::SwapBuffers()
+{
+    {
+        PROFILE_ZONE(EStage::Upload);
+
+        if (enlarged) {
+            enlarged->Enlarge(renderer->Frame(), divisor);
+        }
+
+        const FrameBuffer& frame = enlarged ? *enlarged : renderer->Frame();
+
+        RastPort rastPort;
+        IGraphics->InitRastPort(&rastPort);
+        rastPort.BitMap = backBuffer->Data();
+
+        IGraphics->WritePixelArray(const_cast<Color*>(frame.Data()), 0, 0, static_cast<UWORD>(frame.BytesPerRow()), RECTFMT_RGBA,
+            &rastPort, 0, 0, static_cast<UWORD>(frame.Width()), static_cast<UWORD>(frame.Height()));
+    }
+
+    window.Draw(backBuffer.get());
+}
+
+void CpuContext::SetFocus() const
+{
+    const Window* w = window.WindowPtr();
+
+    if (!w) {
+        return;
+    }
+
+    // Tiles under the pointer first, or in the middle when it is elsewhere
+    const double x = static_cast<double>(w->MouseX - w->BorderLeft) / static_cast<double>(width);
+    const double y = static_cast<double>(w->MouseY - w->BorderTop) / static_cast<double>(height);
+
+    if (x >= 0.0 && x < 1.0 && y >= 0.0 && y < 1.0) {
+        renderer->SetFocus(x, y);
+    } else {
+        renderer->SetFocus(0.5, 0.5);
+    }
+}
+
+bool CpuContext::Refining() const
+{
+    return recompute || accumulating;
+}
+
+void CpuContext::SetPosition(const Vertex64& pos)
+{
+    position = pos;
+}
+
+void CpuContext::SetZoom(const double z)
+{
+    if (view.zoom.ToDouble() != z) {
+        view.zoom = z;
+        recompute = true;
+    }
+}
+
+void CpuContext::SetIterations(const int iter)
+{
+    if (view.iterations != iter) {
+        view.iterations = iter;
+        recompute = true;
+    }
+}
+
+void CpuContext::SetResolutionDivisor(const unsigned d)
+{
+    const unsigned clamped = std::clamp(d, 1u, MaxResolutionDivisor());
+
+    if (divisor != clamped) {
+        divisor = clamped;
+        ResizeRenderer();
+    }
+}
+
+unsigned CpuContext::MaxResolutionDivisor() const
+{
+    return 4;
+}
+
+void CpuContext::Reset()
+{
+    view.pointX = BigFloat {};
+    view.pointY = BigFloat {};
+    panPixels = {};
+    recompute = true;
+}
+
+void CpuContext::UseProgram(const EFractal fractal)
+{
+    if (currentFractal == fractal) {
+        return;
+    }
+
+    logging::Debug("Switch fractal %d", static_cast<int>(fractal));
+
+    currentFractal = fractal;
+
+    const FractalInfo info = GetFractalInfo(fractal);
+
+    view.fractal = fractal;
+    view.complex = info.complex;
+    view.scale = info.scale;
+    view.pointX = BigFloat {};
+    view.pointY = BigFloat {};
+    panPixels = {};
+    recompute = true;
+}
+
+void CpuContext::UsePalette(const EPalette palette)
+{
+    if (currentPalette == palette) {
+        return;
+    }
+
+    currentPalette = palette;
+
+    logging::Debug("Switch palette %d", static_cast<int>(palette));
+
+    renderer->UsePalette(palette);
+    recolor = true;
+}
+
+} // fractalnova
@@ -0,0 +1,91 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "RenderContext.hpp"
+#include "View.hpp"
+
+#include <exec/types.h>
+
+#include <memory>
+
+namespace fractalnova {
+
+class GuiWindow;
+class BackBuffer;
+class CpuRenderer;
+class FrameBuffer;
+
+// Renders with CpuRenderer and presents the result through the same back buffer
+// and window blit as NovaContext
+class CpuContext: public RenderContext
+{
+public:
+    CpuContext(const GuiWindow& window, int iterations, unsigned threads, bool interior, unsigned accumulate);
+    ~CpuContext() override;
+
+    void Resize() override;
+    void Clear() const override;
+    void Draw() const override;
+    void SwapBuffers() override;
+    bool Refining() const override;
+
+    void SetPosition(const Vertex64& position) override;
+    void SetZoom(double zoom) override;
+    void SetIterations(int iterations) override;
+    void SetResolutionDivisor(unsigned divisor) override;
+    unsigned MaxResolutionDivisor() const override;
+    void Reset() override;
+
+    void UseProgram(EFractal fractal) override;
+    void UsePalette(EPalette palette) override;
+
+private:
+    void ResizeRenderer();
+    void SetFocus() const;
+
+    std::unique_ptr<BackBuffer> backBuffer;
+    std::unique_ptr<CpuRenderer> renderer;
+    // Window sized copy of a frame rendered at a lower resolution
+    std::unique_ptr<FrameBuffer> enlarged;
+
+    const GuiWindow& window;
+    uint32 width { 0 };
+    uint32 height { 0 };
+    unsigned divisor { 1 };
+    // Samples per pixel that idle frames add up to
+    unsigned accumulate { 0 };
+
+    Vertex64 position { };
+    mutable View view { };
+    // Panning not applied yet, less than a pixel
+    mutable Vertex64 panPixels { };
+
+    EFractal currentFractal { EFractal::Unknown };
+    EPalette currentPalette { EPalette::Unknown };
+
+    // What the next Draw() has to do
+    mutable bool recompute { true };
+    mutable bool recolor { false };
+    mutable bool accumulating { false };
+};
+
+} // fractalnova
@@ -0,0 +1,1888 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "CpuRenderer.hpp"
+#include "ThreadPool.hpp"
+#include "TileScheduler.hpp"
+#include "FrameBuffer.hpp"
+#include "ColorMap.hpp"
+#include "Palette.hpp"
+#include "EscapeTime.hpp"
+#include "Perturbation.hpp"
+#include "BlaTable.hpp"
+#include "BlueNoise.hpp"
+#include "PrecisionKernel.hpp"
+#include "Profiler.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace fractalnova {
+
+CpuRenderer::CpuRenderer(const unsigned threads):
+    pool(std::make_unique<ThreadPool>(threads)),
+    scheduler(std::make_unique<TileScheduler>(*pool)),
+    frame(std::make_unique<FrameBuffer>(1, 1)),
+    values(1, background),
+    states(1, computePixel),
+    isa(BestIsa())
+{
+    logging::Debug("Create CpuRenderer");
+
+    UsePalette(EPalette::Rainbow);
+}
+
+CpuRenderer::~CpuRenderer() = default;
+
+void CpuRenderer::Resize(const std::uint32_t width, const std::uint32_t height)
+{
+    if (width != frame->Width() || height != frame->Height()) {
+        frame = std::make_unique<FrameBuffer>(std::max(1u, width), std::max(1u, height));
+        values.assign(static_cast<std::size_t>(frame->Width()) * frame->Height(), background);
+        states.assign(values.size(), computePixel);
+        lastValid = false;
+        lastSample = nullptr;
+        accumulation.clear();
+    }
+}
+
+void CpuRenderer::UsePalette(const EPalette palette)
+{
+    Palette p { palette };
+    colorMap = std::make_unique<ColorMap>(p.GetColorArray());
+}
+
+void CpuRenderer::UseIsa(const EIsa i)
+{
+    if (IsSupported(i)) {
+        isa = i;
+    } else {
+        logging::Warning("%s is not supported", IsaName(i));
+    }
+}
+
+void CpuRenderer::UseBla(const bool enabled)
+{
+    useBla = enabled;
+}
+
+void CpuRenderer::UsePrecision(const EPrecision p)
+{
+    precision = p;
+}
+
+void CpuRenderer::SetPrecisionLimits(const PrecisionLimits& limits)
+{
+    precisionLimits = limits;
+}
+
+EPrecision CpuRenderer::SelectPrecision(const FloatExp& zoom) const
+{
+    if (precision != EPrecision::Auto) {
+        return precision;
+    }
+
+    if (zoom <= FloatExp { precisionLimits.floatZoom }) {
+        return EPrecision::Float;
+    }
+
+    if (zoom <= FloatExp { precisionLimits.doubleZoom }) {
+        return EPrecision::Double;
+    }
+
+    if (zoom <= FloatExp { precisionLimits.doubleDoubleZoom }) {
+        return EPrecision::DoubleDouble;
+    }
+
+    if (zoom <= FloatExp { precisionLimits.quadDoubleZoom }) {
+        return EPrecision::QuadDouble;
+    }
+
+    return EPrecision::Perturbation;
+}
+
+void CpuRenderer::UseInteriorDetection(const bool enabled)
+{
+    useInterior = enabled;
+    // Interior values of the last frame are not what this one would produce
+    lastValid = false;
+}
+
+void CpuRenderer::UseSubdivision(const bool enabled)
+{
+    useSubdivision = enabled;
+}
+
+void CpuRenderer::UseSubdivisionGuard(const bool enabled)
+{
+    subdivisionGuard = enabled;
+}
+
+void CpuRenderer::UseDistanceEstimation(const bool enabled)
+{
+    useDistance = enabled;
+    lastValid = false;
+}
+
+void CpuRenderer::UseSupersampling(const unsigned samples, const double budget)
+{
+    maxSamples = std::max(1u, samples);
+    sampleBudget = std::max(0.0, budget);
+}
+
+void CpuRenderer::UseSymmetry(const bool enabled)
+{
+    useSymmetry = enabled;
+}
+
+void CpuRenderer::UseReprojection(const bool enabled)
+{
+    useReprojection = enabled;
+    lastValid = false;
+}
+
+void CpuRenderer::UseOrbitResume(const bool enabled)
+{
+    useResume = enabled;
+}
+
+void CpuRenderer::UseProgressive(const bool enabled)
+{
+    useProgressive = enabled;
+    nextSpacing = 0;
+}
+
+void CpuRenderer::SetFocus(const double x, const double y)
+{
+    scheduler->SetFocus(x, y);
+}
+
+void CpuRenderer::SetCancelCheck(std::function<bool()> check)
+{
+    cancelCheck = std::move(check);
+}
+
+bool CpuRenderer::Cancelled() const
+{
+    return cancelled;
+}
+
+void CpuRenderer::SetBand(const Band& b)
+{
+    band = b;
+}
+
+void CpuRenderer::SwapFrame(std::unique_ptr<FrameBuffer>& other)
+{
+    if (!other || other->Width() != frame->Width() || other->Height() != frame->Height()) {
+        throw std::runtime_error("Swapped frame does not match");
+    }
+
+    frame.swap(other);
+    lastSample = nullptr;
+    accumulation.clear();
+}
+
+double CpuRenderer::ImageHeight() const
+{
+    return static_cast<double>(band.imageHeight ? band.imageHeight : frame->Height());
+}
+
+double CpuRenderer::PixelSpacing(const View& view) const
+{
+    const double fw = static_cast<double>(frame->Width());
+    const double fh = ImageHeight();
+
+    return 2.0 * std::max(static_cast<double>(view.scale.x) / fw, static_cast<double>(view.scale.y) / fh) / view.zoom.ToDouble();
+}
+
+double CpuRenderer::InteriorEpsilon(const View& view) const
+{
+    return useInterior ? PixelSpacing(view) * interiorTolerance : 0.0;
+}
+
+void CpuRenderer::SetPaletteOffset(const float offset)
+{
+    paletteOffset = offset;
+}
+
+void CpuRenderer::Clear()
+{
+    frame->Clear(Color { 0, 0, 0, 255 });
+    std::fill(values.begin(), values.end(), background);
+    std::fill(distances.begin(), distances.end(), 0.0f);
+    std::fill(refinement.begin(), refinement.end(), 0);
+    refinementPixels = 0;
+    sampledPixels.clear();
+    lastValid = false;
+    lastSample = nullptr;
+    accumulation.clear();
+}
+
+void CpuRenderer::Colorize()
+{
+    PROFILE_ZONE(EStage::Colorize);
+
+    ColorRows();
+    BlendSamples();
+    accumulation.clear();
+}
+
+void CpuRenderer::ColorRows()
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    // Outside of the quad the clear colour, like the GPU
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            colorMap->SampleRow(Values(y), frame->Row(y), width, paletteOffset, background, Color { 0, 0, 0, 255 });
+
+            if (!distances.empty()) {
+                ColorMap::ShadeRow(Distances(y), frame->Row(y), width, shadeDistance);
+            }
+        }
+    });
+}
+
+void CpuRenderer::BlendSamples()
+{
+    const std::uint32_t width = frame->Width();
+    const unsigned stride = maxSamples - 1;
+    const unsigned jobs = static_cast<unsigned>((sampledPixels.size() + samplesJob - 1) / samplesJob);
+
+    // Box filter of the antialiased pixels and their sub-samples
+    pool->ParallelFor(jobs, [&](const unsigned job) {
+        const std::size_t end = std::min(sampledPixels.size(), (job + 1) * samplesJob);
+        std::vector<Color> colors(stride, Color { 0, 0, 0 });
+
+        for (std::size_t i = job * samplesJob; i < end; i++) {
+            const SampledPixel& sampled = sampledPixels[i];
+            Color& pixel = frame->Row(static_cast<std::uint32_t>(sampled.index / width))[sampled.index % width];
+
+            colorMap->SampleRow(&sampleValues[i * stride], colors.data(), sampled.count, paletteOffset, background, Color { 0, 0, 0, 255 });
+
+            unsigned r = pixel.r;
+            unsigned g = pixel.g;
+            unsigned b = pixel.b;
+
+            for (unsigned j = 0; j < sampled.count; j++) {
+                r += colors[j].r;
+                g += colors[j].g;
+                b += colors[j].b;
+            }
+
+            const unsigned n = sampled.count + 1;
+
+            pixel.r = static_cast<std::uint8_t>((r + n / 2) / n);
+            pixel.g = static_cast<std::uint8_t>((g + n / 2) / n);
+            pixel.b = static_cast<std::uint8_t>((b + n / 2) / n);
+        }
+    });
+}
+
+float* CpuRenderer::Values(const std::uint32_t y)
+{
+    return values.data() + static_cast<std::size_t>(y) * frame->Width();
+}
+
+float* CpuRenderer::Distances(const std::uint32_t y)
+{
+    return distances.empty() ? nullptr : distances.data() + static_cast<std::size_t>(y) * frame->Width();
+}
+
+void CpuRenderer::Render(const View& view)
+{
+    const EPrecision selected = SelectPrecision(view.zoom);
+    // The orbit kernels are float and do not track the derivative
+    const bool keepOrbits = useResume && selected == EPrecision::Float && !useDistance;
+    const Symmetry symmetry = FindSymmetry(view);
+    // Progressive passes need whole tiles of pixels without subdivision
+    const bool progressive = useProgressive && useReprojection && !useDistance && !useSubdivision;
+    const bool refining = progressive && nextSpacing > 0 && SameView(view);
+
+    lastSample = nullptr;
+    accumulation.clear();
+    stats = PerturbationStats {};
+
+    {
+        PROFILE_ZONE(EStage::Reproject);
+
+        if (!keepOrbits) {
+            orbitIterations.clear();
+            stoppedOrbits.Clear();
+        } else if (orbitIterations.size() != values.size()) {
+            orbitIterations.assign(values.size(), 0.0f);
+        }
+
+        // Distances are not reprojected
+        if (!keepOrbits || !ChangeIterations(view, symmetry)) {
+            if (!useReprojection || useDistance || !Reproject(view)) {
+                std::fill(states.begin(), states.end(), computePixel);
+                stoppedOrbits.Clear();
+            }
+        }
+
+        for (std::size_t i = 0; i < values.size(); i++) {
+            if (states[i] == computePixel) {
+                values[i] = background;
+            }
+
+            if (!orbitIterations.empty() && states[i] != exactPixel && states[i] != resumePixel) {
+                orbitIterations[i] = 0.0f;
+            }
+        }
+    }
+
+    filledPixels = 0;
+    sampledPixels.clear();
+
+    // Only a pass that refines an image already shown may stop
+    std::uint32_t spacing = 1;
+    cancellable = refining;
+    cancelled = false;
+
+    if (refining) {
+        spacing = nextSpacing;
+    } else if (progressive && static_cast<std::size_t>(std::count(states.begin(), states.end(), computePixel)) > values.size() / 4) {
+        spacing = firstSpacing;
+    }
+
+    if (spacing > 1) {
+        DeferPixels(spacing);
+    }
+
+    if (!symmetry.images.empty()) {
+        SkipMirrored(symmetry);
+    }
+
+    if (useDistance && selected != EPrecision::Perturbation) {
+        distances.assign(values.size(), 0.0f);
+    } else {
+        distances.clear();
+    }
+
+    SampleFunction sample;
+
+    switch (selected) {
+        case EPrecision::Perturbation:
+            RenderDeep(view);
+            break;
+        case EPrecision::Double:
+        case EPrecision::DoubleDouble:
+        case EPrecision::QuadDouble:
+            sample = RenderPrecise(view, selected);
+            break;
+        default:
+            sample = RenderFloat(view);
+            break;
+    }
+
+    if (!symmetry.images.empty()) {
+        CopyMirrored(symmetry);
+    }
+
+    cancellable = false;
+
+    // A stopped pass is not shown, its pixels are only left for the next one
+    const bool stopped = cancelled;
+
+    if (spacing > 1 && !stopped) {
+        FillProvisional(spacing);
+    }
+
+    if (!progressive) {
+        nextSpacing = 0;
+    } else if (stopped) {
+        nextSpacing = spacing;
+    } else {
+        nextSpacing = spacing / 2;
+    }
+
+    resumedOrbits.Clear();
+
+    computedPixels = 0;
+    provisionalPixels = 0;
+    mirroredPixels = 0;
+    resumedPixels = 0;
+
+    for (std::size_t i = 0; i < states.size(); i++) {
+        std::uint8_t& state = states[i];
+
+        if (stopped && (state == deferredPixel || ((state == computePixel || state == mirrorPixel) && values[i] == background))) {
+            state = provisionalPixel;
+        }
+
+        if (state == computePixel) {
+            computedPixels++;
+            state = exactPixel;
+        } else if (state == mirrorPixel) {
+            computedPixels++;
+            mirroredPixels++;
+            state = exactPixel;
+        } else if (state == resumePixel) {
+            computedPixels++;
+            resumedPixels++;
+            state = exactPixel;
+        } else if (state == provisionalPixel) {
+            provisionalPixels++;
+        }
+    }
+
+    lastView = view;
+    lastBand = band;
+    lastValid = true;
+
+    FindRefinement();
+
+    // A stopped pass leaves the last image on screen until the next view is
+    // rendered, its values are only kept for that
+    if (!stopped) {
+        PROFILE_ZONE(EStage::Colorize);
+
+        // Edges are found by the colours of the pixels
+        ColorRows();
+
+        // Until the last pass most edges are between provisional blocks
+        if (maxSamples > 1 && sample && nextSpacing == 0) {
+            Supersample(sample);
+        }
+
+        BlendSamples();
+    }
+
+    // Accumulated sub-samples would not match the shading
+    if (!stopped && nextSpacing == 0 && provisionalPixels == 0 && distances.empty()) {
+        lastSample = sample;
+    }
+
+    if (logging::IsVerbose()) {
+        if (spacing > 1 || stopped) {
+            logging::Detail("Pass with spacing %u%s", spacing, stopped ? " cancelled" : "");
+        }
+
+        logging::Detail("%zu pixels computed, %zu of them filled, %zu mirrored and %zu resumed, %zu provisional, %zu need refinement, "
+            "%zu supersampled", computedPixels, FilledPixels(), mirroredPixels, resumedPixels, provisionalPixels, refinementPixels,
+            SupersampledPixels());
+        scheduler->LogStats();
+    }
+}
+
+CpuRenderer::Symmetry CpuRenderer::FindSymmetry(const View& view) const
+{
+    Symmetry symmetry;
+
+    if (!useSymmetry) {
+        return symmetry;
+    }
+
+    const double fw = static_cast<double>(frame->Width());
+    const double fh = ImageHeight();
+
+    // Quad position q is at ndc (q + point) * zoom, so -q is that many pixels
+    // from the mirror of the screen
+    const double shiftX = (view.pointX.ToFloatExp() * view.zoom).ToDouble() * fw;
+    const double shiftY = (view.pointY.ToFloatExp() * view.zoom).ToDouble() * fh;
+
+    const bool columns = std::fabs(shiftX) < fw && std::fabs(shiftX - std::round(shiftX)) <= symmetryTolerance;
+    const bool rows = std::fabs(shiftY) < fh && std::fabs(shiftY - std::round(shiftY)) <= symmetryTolerance;
+
+    symmetry.mirrorX = static_cast<std::int64_t>(fw) - 1 + static_cast<std::int64_t>(std::round(shiftX));
+    symmetry.mirrorY = static_cast<std::int64_t>(fh) - 1 - 2 * static_cast<std::int64_t>(band.top) + static_cast<std::int64_t>(std::round(shiftY));
+
+    if (view.fractal == EFractal::Mandelbrot) {
+        // conj(c)
+        if (rows) {
+            symmetry.images.emplace_back(false, true);
+        }
+    } else {
+        // -z0, and conj(z0) and -conj(z0) when c is real
+        if (rows && columns) {
+            symmetry.images.emplace_back(true, true);
+        }
+
+        if (view.complex.y == 0.0f) {
+            if (rows) {
+                symmetry.images.emplace_back(false, true);
+            }
+
+            if (columns) {
+                symmetry.images.emplace_back(true, false);
+            }
+        }
+    }
+
+    return symmetry;
+}
+
+std::size_t CpuRenderer::MirrorSource(const Symmetry& symmetry, const std::uint32_t x, const std::uint32_t y) const
+{
+    const std::int64_t width = frame->Width();
+    const std::int64_t height = frame->Height();
+
+    std::size_t source = static_cast<std::size_t>(y) * frame->Width() + x;
+
+    for (const auto& [flipColumns, flipRows] : symmetry.images) {
+        const std::int64_t mx = flipColumns ? symmetry.mirrorX - x : x;
+        const std::int64_t my = flipRows ? symmetry.mirrorY - y : y;
+
+        if (mx < 0 || mx >= width || my < 0 || my >= height) {
+            continue;
+        }
+
+        const std::size_t index = static_cast<std::size_t>(my * width + mx);
+
+        source = std::min(source, index);
+    }
+
+    return source;
+}
+
+void CpuRenderer::SkipMirrored(const Symmetry& symmetry)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    // The image with the lowest index is computed. Its own lowest image is
+    // itself, so its state does not change while the others read it.
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                if (states[index] != computePixel) {
+                    continue;
+                }
+
+                const std::size_t source = MirrorSource(symmetry, x, y);
+
+                if (source != index && states[source] == computePixel) {
+                    states[index] = mirrorPixel;
+                }
+            }
+        }
+    });
+}
+
+void CpuRenderer::CopyMirrored(const Symmetry& symmetry)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                if (states[index] != mirrorPixel) {
+                    continue;
+                }
+
+                const std::size_t source = MirrorSource(symmetry, x, y);
+                values[index] = values[source];
+
+                if (!distances.empty()) {
+                    distances[index] = distances[source];
+                }
+            }
+        }
+    });
+}
+
+bool CpuRenderer::ChangeIterations(const View& view, const Symmetry& symmetry)
+{
+    const Vertex point = view.Point();
+    const Vertex lastPoint = lastView.Point();
+
+    // The float kernels see only these
+    if (!lastValid || lastBand.imageHeight != band.imageHeight || lastBand.top != band.top ||
+        lastView.fractal != view.fractal || lastView.iterations == view.iterations ||
+        lastView.complex.x != view.complex.x || lastView.complex.y != view.complex.y ||
+        lastView.scale.x != view.scale.x || lastView.scale.y != view.scale.y ||
+        lastView.Zoom() != view.Zoom() || lastPoint.x != point.x || lastPoint.y != point.y)
+    {
+        return false;
+    }
+
+    const bool julia = view.fractal != EFractal::Mandelbrot;
+    const float lastScale = TextureScale(julia, lastView.iterations);
+    const float scale = TextureScale(julia, view.iterations);
+    const float limit = static_cast<float>(view.iterations);
+    const bool higher = view.iterations > lastView.iterations;
+
+    // The last frame left only exact and provisional pixels. The stopped ones
+    // continue, or have to start over below the old limit.
+    for (const std::size_t index : stoppedOrbits.index) {
+        states[index] = higher ? resumePixel : computePixel;
+    }
+
+    if (higher) {
+        std::swap(resumedOrbits, stoppedOrbits);
+    }
+
+    stoppedOrbits.Clear();
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+                std::uint8_t& state = states[index];
+                float& value = values[index];
+                const float iterations = orbitIterations[index];
+
+                if (state == resumePixel || state == computePixel) {
+                    continue;
+                }
+
+                if (state == provisionalPixel) {
+                    state = computePixel;
+                } else if (value == background) {
+                    state = exactPixel;
+                } else if (iterations > 0.0f && iterations <= limit) {
+                    // Escaped or found inside before the new limit
+                    if (!IsInterior(value)) {
+                        value = value * lastScale / scale;
+                    }
+                } else if (iterations > 0.0f) {
+                    state = computePixel;
+                } else if (!symmetry.images.empty() && MirrorSource(symmetry, x, y) != index) {
+                    state = mirrorPixel;
+                } else if (!higher || !IsInterior(value)) {
+                    // Filled, so only known to be inside
+                    state = computePixel;
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
+void CpuRenderer::MoveOrbits(const std::int64_t dx, const std::int64_t dy)
+{
+    const std::int64_t width = frame->Width();
+    const std::int64_t height = frame->Height();
+
+    StoppedOrbits& orbits = stoppedOrbits;
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < orbits.index.size(); i++) {
+        const std::int64_t x = static_cast<std::int64_t>(orbits.index[i]) % width - dx;
+        const std::int64_t y = static_cast<std::int64_t>(orbits.index[i]) / width - dy;
+
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            continue;
+        }
+
+        orbits.index[kept] = static_cast<std::size_t>(y * width + x);
+        orbits.x[kept] = orbits.x[i];
+        orbits.y[kept] = orbits.y[i];
+        orbits.norm[kept] = orbits.norm[i];
+        orbits.sum[kept] = orbits.sum[i];
+        orbits.savedX[kept] = orbits.savedX[i];
+        orbits.savedY[kept] = orbits.savedY[i];
+        kept++;
+    }
+
+    orbits.index.resize(kept);
+    orbits.x.resize(kept);
+    orbits.y.resize(kept);
+    orbits.norm.resize(kept);
+    orbits.sum.resize(kept);
+    orbits.savedX.resize(kept);
+    orbits.savedY.resize(kept);
+}
+
+void CpuRenderer::KeepOrbits(const std::size_t* indices, const float* results, const OrbitState& orbit, const std::size_t count,
+    const int limit)
+{
+    const float end = static_cast<float>(limit);
+    std::size_t stopped = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        orbitIterations[indices[i]] = orbit.iterations[i];
+
+        if (orbit.iterations[i] >= end && orbit.norm[i] <= 4.0f && !IsInterior(results[i])) {
+            stopped++;
+        }
+    }
+
+    if (stopped == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(orbitMutex);
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (orbit.iterations[i] >= end && orbit.norm[i] <= 4.0f && !IsInterior(results[i])) {
+            stoppedOrbits.index.push_back(indices[i]);
+            stoppedOrbits.x.push_back(orbit.x[i]);
+            stoppedOrbits.y.push_back(orbit.y[i]);
+            stoppedOrbits.norm.push_back(orbit.norm[i]);
+            stoppedOrbits.sum.push_back(orbit.sum[i]);
+            stoppedOrbits.savedX.push_back(orbit.savedX[i]);
+            stoppedOrbits.savedY.push_back(orbit.savedY[i]);
+        }
+    }
+}
+
+bool CpuRenderer::SameView(const View& view) const
+{
+    return lastValid && lastBand.imageHeight == band.imageHeight && lastBand.top == band.top &&
+        lastView.fractal == view.fractal && lastView.iterations == view.iterations &&
+        lastView.complex.x == view.complex.x && lastView.complex.y == view.complex.y &&
+        lastView.scale.x == view.scale.x && lastView.scale.y == view.scale.y &&
+        lastView.zoom == view.zoom && lastView.pointX == view.pointX && lastView.pointY == view.pointY;
+}
+
+bool CpuRenderer::Stopping()
+{
+    if (cancellable && !cancelled.load(std::memory_order_relaxed) && cancelCheck && cancelCheck()) {
+        cancelled = true;
+    }
+
+    return cancelled.load(std::memory_order_relaxed);
+}
+
+void CpuRenderer::DeferPixels(const std::uint32_t spacing)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const std::uint32_t mask = spacing - 1;
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            std::uint8_t* rowStates = &states[static_cast<std::size_t>(y) * width];
+
+            for (std::uint32_t x = 0; x < width; x++) {
+                if (rowStates[x] == computePixel && ((x | y) & mask) != 0) {
+                    rowStates[x] = deferredPixel;
+                }
+            }
+        }
+    });
+}
+
+void CpuRenderer::FillProvisional(const std::uint32_t spacing)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const std::uint32_t mask = ~(spacing - 1);
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    // Blocks of the grid pixel at their top left, which is never deferred
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            const std::size_t row = static_cast<std::size_t>(y) * width;
+            const std::size_t anchorRow = static_cast<std::size_t>(y & mask) * width;
+
+            for (std::uint32_t x = 0; x < width; x++) {
+                if (states[row + x] == deferredPixel) {
+                    values[row + x] = values[anchorRow + (x & mask)];
+                    states[row + x] = provisionalPixel;
+                }
+            }
+        }
+    });
+}
+
+bool CpuRenderer::Reproject(const View& view)
+{
+    if (!lastValid || lastBand.imageHeight != band.imageHeight || lastBand.top != band.top ||
+        lastView.fractal != view.fractal || lastView.iterations != view.iterations ||
+        lastView.complex.x != view.complex.x || lastView.complex.y != view.complex.y ||
+        lastView.scale.x != view.scale.x || lastView.scale.y != view.scale.y)
+    {
+        return false;
+    }
+
+    // Pixel at ndc in this view was at ndc * ratio + shift in the last one
+    const double ratio = (lastView.zoom / view.zoom).ToDouble();
+    const double shiftX = ((lastView.pointX - view.pointX).ToFloatExp() * lastView.zoom).ToDouble();
+    const double shiftY = ((lastView.pointY - view.pointY).ToFloatExp() * lastView.zoom).ToDouble();
+
+    // Nothing left to reuse
+    if (ratio < 1.0 / 64.0 || ratio > 64.0 || std::fabs(shiftX) > 4.0 || std::fabs(shiftY) > 4.0) {
+        return false;
+    }
+
+    std::swap(values, previousValues);
+    std::swap(states, previousStates);
+    std::swap(orbitIterations, previousIterations);
+    values.resize(previousValues.size());
+    states.resize(previousStates.size());
+    orbitIterations.assign(previousIterations.size(), 0.0f);
+
+    const double pixelsX = shiftX * static_cast<double>(frame->Width()) / 2.0;
+    const double pixelsY = shiftY * ImageHeight() / 2.0;
+    const double roundX = std::round(pixelsX);
+    const double roundY = std::round(pixelsY);
+
+    if (ratio != 1.0 || std::fabs(pixelsX - roundX) > 1e-3 || std::fabs(pixelsY - roundY) > 1e-3) {
+        Resample(ratio, shiftX, shiftY);
+        stoppedOrbits.Clear();
+        return true;
+    }
+
+    // Pan by whole pixels: move the last frame and compute the exposed strips.
+    // Provisional pixels are computed now, which also refines a frame that
+    // stopped moving.
+    const std::int64_t width = frame->Width();
+    const std::int64_t height = frame->Height();
+    const std::int64_t dx = static_cast<std::int64_t>(roundX);
+    const std::int64_t dy = static_cast<std::int64_t>(roundY);
+
+    for (std::int64_t y = 0; y < height; y++) {
+        const std::int64_t oldY = y + dy;
+
+        for (std::int64_t x = 0; x < width; x++) {
+            const std::size_t index = static_cast<std::size_t>(y * width + x);
+            const std::int64_t oldX = x + dx;
+
+            if (oldX < 0 || oldX >= width || oldY < 0 || oldY >= height) {
+                states[index] = computePixel;
+                continue;
+            }
+
+            const std::size_t old = static_cast<std::size_t>(oldY * width + oldX);
+
+            values[index] = previousValues[old];
+            states[index] = previousStates[old] == exactPixel ? exactPixel : computePixel;
+
+            if (!orbitIterations.empty()) {
+                orbitIterations[index] = previousIterations[old];
+            }
+        }
+    }
+
+    MoveOrbits(dx, dy);
+
+    return true;
+}
+
+void CpuRenderer::Resample(const double ratio, const double shiftX, const double shiftY)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    const double fw = static_cast<double>(width);
+    const double fh = ImageHeight();
+
+    // Bilinear interpolation between four exact pixels of the last frame, where
+    // they are close enough in value that the result is hard to tell from the
+    // computed one. The rest, and the next frame from a provisional pixel, is
+    // computed, so that a provisional value is never more than one step away.
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            const double ndcY = (2.0 * static_cast<double>(band.top + y) + 1.0) / fh - 1.0;
+            const double oldY = ((ndcY * ratio + shiftY + 1.0) * fh - 1.0) / 2.0 - static_cast<double>(band.top);
+            const double y0 = std::floor(oldY);
+            const float fy = static_cast<float>(oldY - y0);
+
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                const double ndcX = (2.0 * static_cast<double>(x) + 1.0) / fw - 1.0;
+                const double oldX = ((ndcX * ratio + shiftX + 1.0) * fw - 1.0) / 2.0;
+                const double x0 = std::floor(oldX);
+
+                states[index] = computePixel;
+
+                if (x0 < 0.0 || y0 < 0.0 || x0 + 1.0 >= fw || y0 + 1.0 >= static_cast<double>(height)) {
+                    continue;
+                }
+
+                const std::size_t old = static_cast<std::size_t>(y0) * width + static_cast<std::size_t>(x0);
+                const std::size_t corners[4] { old, old + 1, old + width, old + width + 1 };
+
+                float low = previousValues[old];
+                float high = low;
+                bool usable = true;
+
+                for (const std::size_t corner : corners) {
+                    const float value = previousValues[corner];
+                    usable = usable && previousStates[corner] == exactPixel && value != background && !std::isnan(value);
+                    low = std::min(low, value);
+                    high = std::max(high, value);
+                }
+
+                if (!usable || high - low > reprojectTolerance) {
+                    continue;
+                }
+
+                const float fx = static_cast<float>(oldX - x0);
+                const float top = previousValues[corners[0]] + (previousValues[corners[1]] - previousValues[corners[0]]) * fx;
+                const float bottom = previousValues[corners[2]] + (previousValues[corners[3]] - previousValues[corners[2]]) * fx;
+
+                values[index] = top + (bottom - top) * fy;
+                states[index] = provisionalPixel;
+            }
+        }
+    });
+}
+
+void CpuRenderer::FindRefinement()
+{
+    refinementPixels = 0;
+
+    if (distances.empty()) {
+        refinement.clear();
+        return;
+    }
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    refinement.assign(values.size(), 0);
+
+    const auto escaped = [&](const std::size_t index) {
+        return distances[index] > 0.0f;
+    };
+
+    std::atomic<std::size_t> count { 0 };
+
+    // Escaped pixels closer than a pixel to the boundary may have missed a
+    // filament, and the edge of the set runs between an escaped pixel and a
+    // neighbour that did not escape
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+        std::size_t chunkCount = 0;
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                if (values[index] == background) {
+                    continue;
+                }
+
+                const bool refine = escaped(index) ? distances[index] < 1.0f :
+                    (x > 0 && escaped(index - 1)) || (x + 1 < width && escaped(index + 1)) ||
+                    (y > 0 && escaped(index - width)) || (y + 1 < height && escaped(index + width));
+
+                if (refine) {
+                    refinement[index] = 1;
+                    chunkCount++;
+                }
+            }
+        }
+
+        count += chunkCount;
+    });
+
+    refinementPixels = count;
+}
+
+static int Contrast(const Color& a, const Color& b)
+{
+    return std::max({ std::abs(a.r - b.r), std::abs(a.g - b.g), std::abs(a.b - b.b) });
+}
+
+int CpuRenderer::NeighbourContrast(const std::uint32_t x, const std::uint32_t y) const
+{
+    const std::uint32_t width = frame->Width();
+    const std::size_t index = static_cast<std::size_t>(y) * width + x;
+    const Color* row = frame->Row(y);
+
+    int contrast = 0;
+
+    const auto compare = [&](const std::size_t neighbour, const Color& color) {
+        if (values[neighbour] != background) {
+            contrast = std::max(contrast, Contrast(row[x], color));
+        }
+    };
+
+    if (x > 0) {
+        compare(index - 1, row[x - 1]);
+    }
+
+    if (x + 1 < width) {
+        compare(index + 1, row[x + 1]);
+    }
+
+    if (y > 0) {
+        compare(index - width, frame->Row(y - 1)[x]);
+    }
+
+    if (y + 1 < frame->Height()) {
+        compare(index + width, frame->Row(y + 1)[x]);
+    }
+
+    return contrast;
+}
+
+static std::uint32_t Hash(std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Steps of the R2 sequence, from the plastic number
+static constexpr double r2X { 0.7548776662466927 };
+static constexpr double r2Y { 0.5698402909980532 };
+
+// Sub-sample of the pixel: the R2 low-discrepancy sequence, which spreads any
+// number of first points evenly, shifted by a hash of the pixel so that
+// neighbours do not repeat the same pattern
+static void SamplePosition(const std::size_t index, const unsigned sample, double& x, double& y)
+{
+    const std::uint32_t h = Hash(static_cast<std::uint32_t>(index));
+    const double n = static_cast<double>(sample + 1);
+
+    x = static_cast<double>(h & 0xffffu) / 65536.0 + n * r2X;
+    y = static_cast<double>(h >> 16) / 65536.0 + n * r2Y;
+
+    x -= std::floor(x);
+    y -= std::floor(y);
+}
+
+void CpuRenderer::Supersample(const SampleFunction& sample)
+{
+    PROFILE_ZONE(EStage::Supersample);
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    // Contrast and index of the edge pixels. Provisional pixels are computed
+    // again anyway.
+    using Candidate = std::pair<int, std::size_t>;
+    std::vector<std::vector<Candidate>> found(chunks);
+
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                if (values[index] == background || states[index] != exactPixel) {
+                    continue;
+                }
+
+                const int contrast = !refinement.empty() && refinement[index] ? 255 : NeighbourContrast(x, y);
+
+                if (contrast > supersampleContrast) {
+                    found[chunk].push_back(Candidate { contrast, index });
+                }
+            }
+        }
+    });
+
+    std::vector<Candidate> candidates;
+
+    for (const std::vector<Candidate>& chunk : found) {
+        candidates.insert(candidates.end(), chunk.begin(), chunk.end());
+    }
+
+    // Strongest edges first, in case the budget does not reach all of them
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.first > b.first;
+    });
+
+    const unsigned stride = maxSamples - 1;
+    const unsigned first = std::min(firstSamples, stride);
+    std::size_t budget = static_cast<std::size_t>(static_cast<double>(values.size()) * sampleBudget);
+
+    const std::size_t count = std::min(candidates.size(), budget / first);
+    budget -= count * first;
+
+    for (std::size_t i = 0; i < count; i++) {
+        sampledPixels.push_back(SampledPixel { candidates[i].second, 0 });
+    }
+
+    sampleValues.assign(count * stride, 0.0f);
+
+    // Sub-samples [from, to) of the listed entries of sampledPixels
+    const auto run = [&](const std::vector<std::size_t>& list, const unsigned from, const unsigned to) {
+        const unsigned jobs = static_cast<unsigned>((list.size() + samplesJob - 1) / samplesJob);
+
+        pool->ParallelFor(jobs, [&](const unsigned job) {
+            const std::size_t begin = job * samplesJob;
+            const std::size_t end = std::min(list.size(), begin + samplesJob);
+
+            std::vector<double> xs;
+            std::vector<double> ys;
+
+            for (std::size_t i = begin; i < end; i++) {
+                const std::size_t index = sampledPixels[list[i]].index;
+
+                for (unsigned s = from; s < to; s++) {
+                    double sx;
+                    double sy;
+                    SamplePosition(index, s, sx, sy);
+
+                    xs.push_back(static_cast<double>(index % width) + sx);
+                    ys.push_back(static_cast<double>(index / width) + sy);
+                }
+            }
+
+            std::vector<float> results(xs.size());
+            sample(xs.data(), ys.data(), results.data(), xs.size());
+
+            const float* result = results.data();
+
+            for (std::size_t i = begin; i < end; i++) {
+                std::copy(result, result + (to - from), &sampleValues[list[i] * stride + from]);
+                result += to - from;
+                sampledPixels[list[i]].count = to;
+            }
+        });
+    };
+
+    std::vector<std::size_t> list(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        list[i] = i;
+    }
+
+    run(list, 0, first);
+
+    // The rest where the first sub-samples do not agree with the pixel, while
+    // the budget lasts
+    const unsigned rest = stride - first;
+    std::vector<Color> colors(first, Color { 0, 0, 0 });
+
+    list.clear();
+
+    for (std::size_t i = 0; i < count && rest > 0 && budget >= rest; i++) {
+        const std::size_t index = sampledPixels[i].index;
+        const Color& pixel = frame->Row(static_cast<std::uint32_t>(index / width))[index % width];
+
+        colorMap->SampleRow(&sampleValues[i * stride], colors.data(), first, paletteOffset, background, Color { 0, 0, 0, 255 });
+
+        const bool agree = std::all_of(colors.begin(), colors.end(), [&](const Color& color) {
+            return Contrast(pixel, color) <= supersampleContrast;
+        });
+
+        if (!agree) {
+            list.push_back(i);
+            budget -= rest;
+        }
+    }
+
+    run(list, first, stride);
+}
+
+bool CpuRenderer::Accumulate()
+{
+    if (!lastSample || AccumulatedSamples() >= maxAccumulated) {
+        return false;
+    }
+
+    PROFILE_ZONE(EStage::Supersample);
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const unsigned chunks = (height + jobRows - 1) / jobRows;
+
+    if (accumulation.empty()) {
+        // The frame is the first sample, at the centres of the pixels
+        accumulation.resize(values.size() * 3);
+
+        for (std::uint32_t y = 0; y < height; y++) {
+            const Color* row = frame->Row(y);
+            float* sums = &accumulation[static_cast<std::size_t>(y) * width * 3];
+
+            for (std::uint32_t x = 0; x < width; x++) {
+                sums[x * 3] = row[x].r;
+                sums[x * 3 + 1] = row[x].g;
+                sums[x * 3 + 2] = row[x].b;
+            }
+        }
+
+        chunkSamples.assign(chunks, 1);
+    }
+
+    if (!noiseX) {
+        noiseX = std::make_unique<BlueNoise>(1);
+        noiseY = std::make_unique<BlueNoise>(2);
+    }
+
+    // Chunks that a stopped call left behind catch up first
+    const unsigned count = *std::min_element(chunkSamples.begin(), chunkSamples.end()) + 1;
+    const double shiftX = static_cast<double>(count) * r2X;
+    const double shiftY = static_cast<double>(count) * r2Y;
+
+    cancellable = true;
+    cancelled = false;
+
+    // Outside of the quad stays background
+    pool->ParallelFor(chunks, [&](const unsigned chunk) {
+        if (chunkSamples[chunk] >= count) {
+            return;
+        }
+
+        const std::uint32_t end = std::min(height, (chunk + 1) * jobRows);
+
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<std::size_t> indices;
+
+        for (std::uint32_t y = chunk * jobRows; y < end; y++) {
+            for (std::uint32_t x = 0; x < width; x++) {
+                const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                if (values[index] == background) {
+                    continue;
+                }
+
+                const double sx = noiseX->Value(x, y) + shiftX;
+                const double sy = noiseY->Value(x, y) + shiftY;
+
+                xs.push_back(static_cast<double>(x) + sx - std::floor(sx));
+                ys.push_back(static_cast<double>(y) + sy - std::floor(sy));
+                indices.push_back(index);
+            }
+        }
+
+        std::vector<float> results(xs.size());
+
+        for (std::size_t start = 0; start < xs.size(); start += pixelBatch) {
+            if (Stopping()) {
+                return;
+            }
+
+            lastSample(&xs[start], &ys[start], &results[start], std::min(pixelBatch, xs.size() - start));
+        }
+
+        std::vector<Color> colors(results.size(), Color { 0, 0, 0 });
+        colorMap->SampleRow(results.data(), colors.data(), results.size(), paletteOffset, background, Color { 0, 0, 0, 255 });
+
+        const float scale = 1.0f / static_cast<float>(count);
+
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            float* sums = &accumulation[indices[i] * 3];
+            Color& pixel = frame->Row(static_cast<std::uint32_t>(indices[i] / width))[indices[i] % width];
+
+            sums[0] += colors[i].r;
+            sums[1] += colors[i].g;
+            sums[2] += colors[i].b;
+
+            pixel.r = static_cast<std::uint8_t>(sums[0] * scale + 0.5f);
+            pixel.g = static_cast<std::uint8_t>(sums[1] * scale + 0.5f);
+            pixel.b = static_cast<std::uint8_t>(sums[2] * scale + 0.5f);
+        }
+
+        chunkSamples[chunk] = count;
+    });
+
+    cancellable = false;
+
+    return true;
+}
+
+// Palette texture coordinate of a kernel result
+static float TextureCoordinate(const float result, const float textureScale)
+{
+    return IsInterior(result) ? result : result / textureScale;
+}
+
+void CpuRenderer::RenderTile(const Tile& tile, const InsideQuad& inside, const Subdivision::Evaluate& evaluate)
+{
+    PROFILE_ZONE(EStage::Tile);
+
+    if (Stopping()) {
+        return;
+    }
+
+    const std::uint32_t width = frame->Width();
+
+    // Outside of the quad stays background, like the GPU keeps what Clear()
+    // left there. Reprojected pixels are not computed again.
+    std::vector<Pixel> pixels;
+    pixels.reserve(static_cast<std::size_t>(tile.width) * tile.height);
+
+    for (std::uint32_t y = tile.y; y < tile.y + tile.height; y++) {
+        const std::uint8_t* rowStates = &states[static_cast<std::size_t>(y) * width];
+
+        for (std::uint32_t x = tile.x; x < tile.x + tile.width; x++) {
+            if (rowStates[x] == computePixel && inside(x, y)) {
+                pixels.push_back(Pixel { x, y });
+            }
+        }
+    }
+
+    if (useSubdivision && distances.empty() && pixels.size() == static_cast<std::size_t>(tile.width) * tile.height) {
+        Subdivision subdivision { values.data(), width, evaluate, subdivisionGuard };
+        filledPixels += subdivision.Render(tile);
+    } else if (!pixels.empty()) {
+        evaluate(pixels.data(), pixels.size());
+    }
+}
+
+CpuRenderer::SampleFunction CpuRenderer::RenderFloat(const View& view)
+{
+    const bool julia = view.fractal != EFractal::Mandelbrot;
+    const float textureScale = TextureScale(julia, view.iterations);
+    const RowKernel kernel = GetRowKernel(isa, julia);
+    const OrbitKernel orbitKernel = orbitIterations.empty() ? nullptr : GetOrbitKernel(isa, julia);
+    const KernelParams params { view.iterations, view.complex, InteriorEpsilon(view), PixelSpacing(view) };
+
+    const std::uint32_t width = frame->Width();
+    const float zoom = view.Zoom();
+    const Vertex point = view.Point();
+
+    const float fw = static_cast<float>(frame->Width());
+    const float fh = static_cast<float>(ImageHeight());
+
+    // Undo the vertex shader transform: window position -> quad position
+    const auto quadX = [&](const std::uint32_t x) {
+        const float ndcX = (2.0f * static_cast<float>(x) + 1.0f) / fw - 1.0f;
+        return ndcX / zoom - point.x;
+    };
+
+    const auto quadY = [&](const std::uint32_t y) {
+        const float ndcY = (2.0f * static_cast<float>(band.top + y) + 1.0f) / fh - 1.0f;
+        return ndcY / zoom - point.y;
+    };
+
+    const InsideQuad inside = [&](const std::uint32_t x, const std::uint32_t y) {
+        return std::fabs(quadX(x)) <= 1.0f && std::fabs(quadY(y)) <= 1.0f;
+    };
+
+    const Subdivision::Evaluate evaluate = [&](const Pixel* pixels, const std::size_t count) {
+        float xs[pixelBatch];
+        float ys[pixelBatch];
+        float results[pixelBatch];
+        float estimates[pixelBatch];
+
+        std::size_t indices[pixelBatch];
+        float orbitX[pixelBatch];
+        float orbitY[pixelBatch];
+        float orbitNorm[pixelBatch];
+        float orbitIteration[pixelBatch];
+        float orbitSum[pixelBatch];
+        float savedX[pixelBatch];
+        float savedY[pixelBatch];
+        const OrbitState orbit { orbitX, orbitY, orbitNorm, orbitIteration, orbitSum, savedX, savedY };
+
+        // Smaller batches poll more often in passes that may stop
+        const std::size_t batch = cancellable ? stopBatch : pixelBatch;
+
+        for (std::size_t start = 0; start < count && !Stopping(); start += batch) {
+            const std::size_t n = std::min(batch, count - start);
+
+            for (std::size_t i = 0; i < n; i++) {
+                xs[i] = quadX(pixels[start + i].x) * view.scale.x;
+                ys[i] = quadY(pixels[start + i].y) * view.scale.y;
+            }
+
+            if (orbitKernel) {
+                for (std::size_t i = 0; i < n; i++) {
+                    indices[i] = static_cast<std::size_t>(pixels[start + i].y) * width + pixels[start + i].x;
+                    orbitIteration[i] = 0.0f;
+                }
+
+                orbitKernel(xs, ys, results, orbit, static_cast<unsigned>(n), params);
+                KeepOrbits(indices, results, orbit, n, view.iterations);
+            } else {
+                kernel(xs, ys, results, distances.empty() ? nullptr : estimates, static_cast<unsigned>(n), params);
+            }
+
+            for (std::size_t i = 0; i < n; i++) {
+                Values(pixels[start + i].y)[pixels[start + i].x] = TextureCoordinate(results[i], textureScale);
+            }
+
+            if (!distances.empty()) {
+                for (std::size_t i = 0; i < n; i++) {
+                    Distances(pixels[start + i].y)[pixels[start + i].x] = estimates[i];
+                }
+            }
+        }
+    };
+
+    scheduler->Run(frame->Width(), frame->Height(), [&](const Tile& tile) { RenderTile(tile, inside, evaluate); });
+
+    if (!resumedOrbits.index.empty()) {
+        // The orbits that stopped at the last limit continue from there, and
+        // are the only ones that take more iterations
+        StoppedOrbits& orbits = resumedOrbits;
+        const std::size_t count = orbits.index.size();
+        const unsigned jobs = static_cast<unsigned>((count + pixelBatch - 1) / pixelBatch);
+
+        pool->ParallelFor(jobs, [&](const unsigned job) {
+            PROFILE_ZONE(EStage::Tile);
+
+            const std::size_t start = job * pixelBatch;
+            const std::size_t n = std::min(pixelBatch, count - start);
+            const std::size_t* indices = &orbits.index[start];
+
+            float xs[pixelBatch];
+            float ys[pixelBatch];
+            float results[pixelBatch];
+            float iterations[pixelBatch];
+
+            for (std::size_t i = 0; i < n; i++) {
+                const std::uint32_t x = static_cast<std::uint32_t>(indices[i] % width);
+                const std::uint32_t y = static_cast<std::uint32_t>(indices[i] / width);
+
+                xs[i] = quadX(x) * view.scale.x;
+                ys[i] = quadY(y) * view.scale.y;
+                iterations[i] = orbitIterations[indices[i]];
+            }
+
+            const OrbitState orbit {
+                &orbits.x[start], &orbits.y[start], &orbits.norm[start], iterations, &orbits.sum[start],
+                &orbits.savedX[start], &orbits.savedY[start]
+            };
+
+            orbitKernel(xs, ys, results, orbit, static_cast<unsigned>(n), params);
+
+            for (std::size_t i = 0; i < n; i++) {
+                values[indices[i]] = TextureCoordinate(results[i], textureScale);
+            }
+
+            KeepOrbits(indices, results, orbit, n, view.iterations);
+        });
+    }
+
+    // Called after this returns, so everything is captured by value
+    const Vertex scale = view.scale;
+    const double top = static_cast<double>(band.top);
+
+    return [=](const double* x, const double* y, float* out, const std::size_t count) {
+        float xs[pixelBatch];
+        float ys[pixelBatch];
+        float results[pixelBatch];
+
+        for (std::size_t start = 0; start < count; start += pixelBatch) {
+            const std::size_t n = std::min(pixelBatch, count - start);
+
+            for (std::size_t i = 0; i < n; i++) {
+                xs[i] = (static_cast<float>(2.0 * x[start + i] / fw - 1.0) / zoom - point.x) * scale.x;
+                ys[i] = (static_cast<float>(2.0 * (top + y[start + i]) / fh - 1.0) / zoom - point.y) * scale.y;
+            }
+
+            kernel(xs, ys, results, nullptr, static_cast<unsigned>(n), params);
+
+            for (std::size_t i = 0; i < n; i++) {
+                out[start + i] = TextureCoordinate(results[i], textureScale);
+            }
+        }
+    };
+}
+
+CpuRenderer::SampleFunction CpuRenderer::RenderPrecise(const View& view, const EPrecision selected)
+{
+    const bool julia = view.fractal != EFractal::Mandelbrot;
+    const float textureScale = TextureScale(julia, view.iterations);
+    const PrecisionKernel kernel = GetPrecisionKernel(selected, julia);
+    const KernelParams params { view.iterations, view.complex, InteriorEpsilon(view), PixelSpacing(view) };
+
+    const double fw = static_cast<double>(frame->Width());
+    const double fh = ImageHeight();
+
+    const double zoom = view.zoom.ToDouble();
+    const double pointX = view.pointX.ToDouble();
+    const double pointY = view.pointY.ToDouble();
+
+    const double scaleX = static_cast<double>(view.scale.x);
+    const double scaleY = static_cast<double>(view.scale.y);
+
+    // Screen centre is at quad position -point, with enough bits for quad-double
+    const unsigned limbs = BigFloat::LimbsForBits(static_cast<unsigned>(std::max(0.0, std::log2(zoom))) + 256);
+
+    PrecisionRow centre {};
+    (-(view.pointX.WithLimbs(limbs) * BigFloat { scaleX, limbs })).Split(centre.centreX, 4);
+    (-(view.pointY.WithLimbs(limbs) * BigFloat { scaleY, limbs })).Split(centre.centreY, 4);
+
+    const auto ndcX = [&](const std::uint32_t x) {
+        return (2.0 * static_cast<double>(x) + 1.0) / fw - 1.0;
+    };
+
+    const auto ndcY = [&](const std::uint32_t y) {
+        return (2.0 * static_cast<double>(band.top + y) + 1.0) / fh - 1.0;
+    };
+
+    const InsideQuad inside = [&](const std::uint32_t x, const std::uint32_t y) {
+        return std::fabs(ndcX(x) / zoom - pointX) <= 1.0 && std::fabs(ndcY(y) / zoom - pointY) <= 1.0;
+    };
+
+    const Subdivision::Evaluate evaluate = [&](const Pixel* pixels, const std::size_t count) {
+        double offsetsX[pixelBatch];
+        double offsetsY[pixelBatch];
+        float results[pixelBatch];
+        float estimates[pixelBatch];
+
+        PrecisionRow row = centre;
+        row.offsetX = offsetsX;
+        row.offsetY = offsetsY;
+
+        // Smaller batches poll more often in passes that may stop
+        const std::size_t batch = cancellable ? stopBatch : pixelBatch;
+
+        for (std::size_t start = 0; start < count && !Stopping(); start += batch) {
+            const std::size_t n = std::min(batch, count - start);
+
+            for (std::size_t i = 0; i < n; i++) {
+                offsetsX[i] = ndcX(pixels[start + i].x) * scaleX / zoom;
+                offsetsY[i] = ndcY(pixels[start + i].y) * scaleY / zoom;
+            }
+
+            kernel(row, results, distances.empty() ? nullptr : estimates, static_cast<unsigned>(n), params);
+
+            for (std::size_t i = 0; i < n; i++) {
+                Values(pixels[start + i].y)[pixels[start + i].x] = TextureCoordinate(results[i], textureScale);
+            }
+
+            if (!distances.empty()) {
+                for (std::size_t i = 0; i < n; i++) {
+                    Distances(pixels[start + i].y)[pixels[start + i].x] = estimates[i];
+                }
+            }
+        }
+    };
+
+    scheduler->Run(frame->Width(), frame->Height(), [&](const Tile& tile) { RenderTile(tile, inside, evaluate); });
+
+    // Called after this returns, so everything is captured by value
+    const double top = static_cast<double>(band.top);
+
+    return [=](const double* x, const double* y, float* out, const std::size_t count) {
+        double offsetsX[pixelBatch];
+        double offsetsY[pixelBatch];
+        float results[pixelBatch];
+
+        PrecisionRow row = centre;
+        row.offsetX = offsetsX;
+        row.offsetY = offsetsY;
+
+        for (std::size_t start = 0; start < count; start += pixelBatch) {
+            const std::size_t n = std::min(pixelBatch, count - start);
+
+            for (std::size_t i = 0; i < n; i++) {
+                offsetsX[i] = (2.0 * x[start + i] / fw - 1.0) * scaleX / zoom;
+                offsetsY[i] = (2.0 * (top + y[start + i]) / fh - 1.0) * scaleY / zoom;
+            }
+
+            kernel(row, results, nullptr, static_cast<unsigned>(n), params);
+
+            for (std::size_t i = 0; i < n; i++) {
+                out[start + i] = TextureCoordinate(results[i], textureScale);
+            }
+        }
+    };
+}
+
+void CpuRenderer::RenderDeep(const View& view)
+{
+    const bool julia = view.fractal != EFractal::Mandelbrot;
+    const float textureScale = TextureScale(julia, view.iterations);
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+
+    const double fw = static_cast<double>(width);
+    const double fh = ImageHeight();
+
+    // Only used for finding the edges of the quad, which matter at low zoom
+    const double zoom = view.zoom.ToDouble();
+    const double pointX = view.pointX.ToDouble();
+    const double pointY = view.pointY.ToDouble();
+
+    const double scaleX = static_cast<double>(view.scale.x);
+    const double scaleY = static_cast<double>(view.scale.y);
+
+    // The reference needs enough bits to resolve neighbouring pixels, plus headroom
+    // for the error that builds up over the iterations
+    const FloatExp spacing = FloatExp { 2.0 * std::max(scaleX / fw, scaleY / fh) } / view.zoom;
+    const unsigned limbs = BigFloat::LimbsForBits(static_cast<unsigned>(std::max(0.0, -spacing.Log2())) + 64);
+
+    // Screen centre is at quad position -point
+    BigFloat refX = -(view.pointX.WithLimbs(limbs) * BigFloat { scaleX, limbs });
+    BigFloat refY = -(view.pointY.WithLimbs(limbs) * BigFloat { scaleY, limbs });
+
+    PerturbationParams params;
+    params.julia = julia;
+    params.iterations = view.iterations;
+    params.doubleDeltas = FitsDouble(spacing);
+
+    // Any pixel is within the screen diagonal from any reference
+    const double maxDeltaC = (FloatExp { 2.0 * std::hypot(scaleX, scaleY) } / view.zoom).ToDouble();
+
+    stats = PerturbationStats {};
+    stats.bits = limbs * 32;
+    stats.doubleDeltas = params.doubleDeltas;
+
+    glitched.assign(static_cast<std::size_t>(width) * height, 0);
+
+    // Offset of the current reference from the screen centre
+    FloatExp offsetX;
+    FloatExp offsetY;
+
+    std::atomic<std::uint64_t> pixels { 0 };
+    std::atomic<std::uint64_t> iterations { 0 };
+    std::atomic<std::uint64_t> skipped { 0 };
+    std::atomic<std::uint64_t> rebases { 0 };
+    std::atomic<std::uint64_t> glitches { 0 };
+
+    const auto pass = [&](const ReferenceOrbit& reference, const BlaTable* table, const bool retry) {
+        params.bla = table;
+
+        glitches = 0;
+        stats.references++;
+
+        scheduler->Run(width, height, [&](const Tile& tile) {
+            PROFILE_ZONE(EStage::Tile);
+
+            std::uint64_t tilePixels = 0;
+            std::uint64_t tileIterations = 0;
+            std::uint64_t tileSkipped = 0;
+            std::uint64_t tileRebases = 0;
+            std::uint64_t tileGlitches = 0;
+
+            for (std::uint32_t y = tile.y; y < tile.y + tile.height; y++) {
+                const double ndcY = (2.0 * static_cast<double>(band.top + y) + 1.0) / fh - 1.0;
+
+                if (std::fabs(ndcY / zoom - pointY) > 1.0) {
+                    continue;
+                }
+
+                const FloatExp dy = FloatExp { ndcY * scaleY } / view.zoom - offsetY;
+
+                for (std::uint32_t x = tile.x; x < tile.x + tile.width; x++) {
+                    const std::size_t index = static_cast<std::size_t>(y) * width + x;
+
+                    if (states[index] != computePixel || (retry && !glitched[index])) {
+                        continue;
+                    }
+
+                    if (Stopping()) {
+                        break;
+                    }
+
+                    const double ndcX = (2.0 * static_cast<double>(x) + 1.0) / fw - 1.0;
+
+                    if (std::fabs(ndcX / zoom - pointX) > 1.0) {
+                        continue;
+                    }
+
+                    const FloatExp dx = FloatExp { ndcX * scaleX } / view.zoom - offsetX;
+                    const PerturbationResult result = Perturb(reference, dx, dy, params);
+
+                    glitched[index] = result.glitched ? 1 : 0;
+
+                    tilePixels++;
+                    tileIterations += static_cast<std::uint64_t>(result.iterations);
+                    tileSkipped += result.skipped;
+                    tileRebases += result.rebases;
+                    tileGlitches += result.glitched ? 1 : 0;
+
+                    values[index] = result.value / textureScale;
+                }
+            }
+
+            pixels += tilePixels;
+            iterations += tileIterations;
+            skipped += tileSkipped;
+            rebases += tileRebases;
+            glitches += tileGlitches;
+        });
+
+        params.bla = nullptr;
+    };
+
+    {
+        PROFILE_ZONE(EStage::Reference);
+
+        if (!cached.orbit || cached.orbit->X() != refX || cached.orbit->Y() != refY ||
+            cached.fractal != view.fractal || cached.iterations != view.iterations)
+        {
+            cached.orbit = std::make_unique<ReferenceOrbit>(refX, refY, julia, view.complex, view.iterations);
+            cached.bla.reset();
+            cached.fractal = view.fractal;
+            cached.iterations = view.iterations;
+        }
+
+        if (useBla && (!cached.bla || cached.maxDeltaC != maxDeltaC)) {
+            cached.bla = std::make_unique<BlaTable>(*cached.orbit, julia, maxDeltaC);
+            cached.maxDeltaC = maxDeltaC;
+        }
+    }
+
+    pass(*cached.orbit, useBla ? cached.bla.get() : nullptr, false);
+
+    logging::Debug("Perturbation: %u bits, %s deltas, %" PRIu64 " rebases, %" PRIu64 " glitches", stats.bits,
+        params.doubleDeltas ? "double" : "extended", rebases.load(), glitches.load());
+
+    for (unsigned references = 0; references < maxReferences && glitches > 0 && !Stopping(); references++) {
+        // Take the next reference from a glitched pixel, it is correct for that one
+        // at least and often for the blob around it
+        const std::size_t index = static_cast<std::size_t>(std::find(glitched.begin(), glitched.end(), 1) - glitched.begin());
+
+        const double ndcX = (2.0 * static_cast<double>(index % width) + 1.0) / fw - 1.0;
+        const double ndcY = (2.0 * static_cast<double>(band.top + index / width) + 1.0) / fh - 1.0;
+
+        const FloatExp dx = FloatExp { ndcX * scaleX } / view.zoom;
+        const FloatExp dy = FloatExp { ndcY * scaleY } / view.zoom;
+
+        offsetX = dx;
+        offsetY = dy;
+
+        std::unique_ptr<ReferenceOrbit> reference;
+        std::unique_ptr<BlaTable> table;
+
+        {
+            PROFILE_ZONE(EStage::Reference);
+
+            reference = std::make_unique<ReferenceOrbit>(refX + BigFloat { dx, limbs }, refY + BigFloat { dy, limbs }, julia, view.complex, view.iterations);
+
+            if (useBla) {
+                table = std::make_unique<BlaTable>(*reference, julia, maxDeltaC);
+            }
+        }
+
+        pass(*reference, table.get(), true);
+
+        logging::Debug("Reference %u fixed glitches, %" PRIu64 " remain", references + 1, glitches.load());
+    }
+
+    if (cancelled) {
+        // Not fixed, so the next pass computes them again
+        for (std::size_t index = 0; index < glitched.size(); index++) {
+            if (glitched[index]) {
+                values[index] = background;
+            }
+        }
+    }
+
+    stats.pixels = pixels;
+    stats.iterations = iterations;
+    stats.skipped = skipped;
+    stats.rebases = rebases;
+    stats.glitches = glitches;
+
+    if (stats.pixels > 0) {
+        logging::Debug("%.1f iterations per pixel, %.1f skipped", static_cast<double>(stats.iterations) / static_cast<double>(stats.pixels),
+            static_cast<double>(stats.skipped) / static_cast<double>(stats.pixels));
+    }
+}
+
+const FrameBuffer& CpuRenderer::Frame() const
+{
+    return *frame;
+}
+
+std::size_t CpuRenderer::ComputedPixels() const
+{
+    return computedPixels;
+}
+
+std::size_t CpuRenderer::ProvisionalPixels() const
+{
+    return provisionalPixels;
+}
+
+std::size_t CpuRenderer::FilledPixels() const
+{
+    return filledPixels.load();
+}
+
+std::size_t CpuRenderer::MirroredPixels() const
+{
+    return mirroredPixels;
+}
+
+std::size_t CpuRenderer::ResumedPixels() const
+{
+    return resumedPixels;
+}
+
+float CpuRenderer::Distance(const std::uint32_t x, const std::uint32_t y) const
+{
+    return distances.empty() ? 0.0f : distances[static_cast<std::size_t>(y) * frame->Width() + x];
+}
+
+bool CpuRenderer::NeedsRefinement(const std::uint32_t x, const std::uint32_t y) const
+{
+    return !refinement.empty() && refinement[static_cast<std::size_t>(y) * frame->Width() + x];
+}
+
+std::size_t CpuRenderer::RefinementPixels() const
+{
+    return refinementPixels;
+}
+
+unsigned CpuRenderer::AccumulatedSamples() const
+{
+    return accumulation.empty() ? 1 : *std::min_element(chunkSamples.begin(), chunkSamples.end());
+}
+
+std::size_t CpuRenderer::SupersampledPixels() const
+{
+    return sampledPixels.size();
+}
+
+const PerturbationStats& CpuRenderer::DeepStats() const
+{
+    return stats;
+}
+
+const TileScheduler& CpuRenderer::Scheduler() const
+{
+    return *scheduler;
+}
+
+unsigned CpuRenderer::Threads() const
+{
+    return pool->Size();
+}
+
+EIsa CpuRenderer::Isa() const
+{
+    return isa;
+}
+
+} // fractalnova
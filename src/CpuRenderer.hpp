@@ -0,0 +1,437 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "View.hpp"
+#include "EPalette.hpp"
+#include "SimdKernel.hpp"
+#include "EPrecision.hpp"
+#include "Perturbation.hpp"
+#include "Subdivision.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace fractalnova {
+
+class ThreadPool;
+class TileScheduler;
+class FrameBuffer;
+class ColorMap;
+class BlaTable;
+class BlueNoise;
+struct Tile;
+
+// Deepest zoom levels where each precision is still used. Past the last one
+// the renderer switches to perturbation. Setting a limit equal to the previous
+// one skips that precision. "bench precision" shows where each one breaks.
+struct PrecisionLimits
+{
+    // Float coordinates start to run out of bits
+    double floatZoom { 1e3 };
+    double doubleZoom { 1e10 };
+    double doubleDoubleZoom { 1e25 };
+    double quadDoubleZoom { 1e55 };
+};
+
+// Rows [top, top + frame height) of a taller image, for images that do not fit
+// in memory. Zero image height means the frame is the whole image.
+struct Band
+{
+    std::uint32_t imageHeight { 0 };
+    std::uint32_t top { 0 };
+};
+
+// Multithreaded software renderer producing the same image as the shaders.
+// Does not depend on Intuition or Warp3D Nova. Past the range of floats it
+// continues with double, double-double and quad-double arithmetic and finally
+// perturbation against a high precision reference orbit.
+class CpuRenderer
+{
+public:
+    // Additional reference orbits used for fixing glitched Julia pixels
+    static constexpr unsigned maxReferences { 32 };
+
+    explicit CpuRenderer(unsigned threads = 0);
+    ~CpuRenderer();
+
+    void Resize(std::uint32_t width, std::uint32_t height);
+    void UsePalette(EPalette palette);
+    void UseIsa(EIsa isa);
+    // Series approximation (BLA) for perturbation, on by default
+    void UseBla(bool enabled);
+    // Auto picks by zoom level
+    void UsePrecision(EPrecision precision);
+    void SetPrecisionLimits(const PrecisionLimits& limits);
+    EPrecision SelectPrecision(const FloatExp& zoom) const;
+
+    // Stop iterating pixels inside the set when they are in the main cardioid
+    // or the period 2 bulb or when their orbit is found to cycle. Off by
+    // default, because the shaders colour interior pixels by their last
+    // iteration. Not used by perturbation.
+    void UseInteriorDetection(bool enabled);
+
+    // Mariani-Silver subdivision of the tiles: rectangles with a uniform
+    // border are filled instead of computed. Useful with interior detection.
+    // Off by default, and not used by perturbation.
+    void UseSubdivision(bool enabled);
+    // Check a sparse grid inside before filling, on by default
+    void UseSubdivisionGuard(bool enabled);
+
+    // Track the derivative in the kernels and keep the exterior distance of
+    // every pixel. The colours are darkened towards the boundary of the set and
+    // NeedsRefinement() tells which pixels are too close to it to be resolved.
+    // Off by default. Turns off reprojection and subdivision, which would leave
+    // pixels without a distance, and is not supported by perturbation.
+    void UseDistanceEstimation(bool enabled);
+
+    // Antialiasing of the edges: pixels whose colour differs from a neighbour,
+    // or that NeedsRefinement(), get jittered sub-samples. Four first, and up
+    // to samples in total when those differ too. budget is the number of
+    // sub-samples per pixel of the frame at most, the strongest edges get
+    // them first. Sub-samples cost more than the average pixel, because edges
+    // take the most iterations. samples 1 turns it off, the default. Not used
+    // by perturbation.
+    void UseSupersampling(unsigned samples, double budget = 0.1);
+
+    // Compute only one of the pixels that are mirror images of each other and
+    // copy the value to the rest: Mandelbrot is symmetric about the real axis,
+    // Julia sets about the origin and with a real constant also about both
+    // axes. Only when the mirror falls exactly on the pixel grid, like in the
+    // initial view. On by default.
+    void UseSymmetry(bool enabled);
+
+    // Reuse the values of the previous frame when the view only moved or
+    // zoomed, on by default. Clear() starts over.
+    void UseReprojection(bool enabled);
+
+    // Keep where the orbits of the pixels that did not escape stopped. When
+    // only the iteration limit changes, a higher one continues them and a lower
+    // one computes again only the pixels that escaped after it. The texture
+    // coordinates of the rest are rescaled, which can round a colour by one
+    // step. On by default, float precision without distance estimation.
+    void UseOrbitResume(bool enabled);
+
+    // Render a new view in passes: the first computes every 16th pixel in both
+    // directions and shows blocks of them, and every Render() of the same view
+    // after it halves the spacing, until all pixels are computed. The pixels
+    // that are not computed yet count as ProvisionalPixels(). Only when most of
+    // the frame is new. Off by default, needs reprojection and does not work
+    // with distance estimation or subdivision.
+    void UseProgressive(bool enabled);
+    // Where the user looks, in fractions of the frame. Its tiles are computed
+    // first. The centre by default.
+    void SetFocus(double x, double y);
+    // Polled between batches of pixels on every render thread. When it returns
+    // true, the pass stops without colouring the frame, which keeps the last
+    // image, and the next Render() of the view continues it. Only passes after
+    // the first of a progressive render stop, so that every view shows
+    // something.
+    void SetCancelCheck(std::function<bool()> check);
+    // The last Render() was stopped by the cancel check
+    bool Cancelled() const;
+
+    void SetBand(const Band& band);
+    // Exchange the frame with one of the same size, so that another thread can
+    // use the finished one while the next is rendered
+    void SwapFrame(std::unique_ptr<FrameBuffer>& other);
+
+    void Clear();
+    // Computes the values of the frame and colours them
+    void Render(const View& view);
+    // Colours the values of the last frame again, after UsePalette() or
+    // SetPaletteOffset(). Costs a palette lookup per pixel.
+    void Colorize();
+    // Added to the texture coordinate, for cycling the colours
+    void SetPaletteOffset(float offset);
+    // Adds one jittered sample to every pixel of the last frame and shows the
+    // running average, which antialiases the view while it stays. The jitter
+    // is blue noise, shifted along the R2 sequence for each sample. Returns
+    // false when there is nothing to add: the frame is not complete, is shaded
+    // by distance or was rendered with perturbation, or has maxAccumulated
+    // samples. Render() and Colorize() start over. The cancel check stops it
+    // between rows, which keeps what was done.
+    bool Accumulate();
+
+    const FrameBuffer& Frame() const;
+    // Pixels computed by the last Render()
+    std::size_t ComputedPixels() const;
+    // Pixels of the last Render() that were resampled from the previous frame
+    // and are computed by the next Render() of the same view
+    std::size_t ProvisionalPixels() const;
+    // Computed pixels of the last Render() that subdivision filled
+    std::size_t FilledPixels() const;
+    // Computed pixels of the last Render() that were copied from their mirror
+    std::size_t MirroredPixels() const;
+    // Computed pixels of the last Render() that continued their orbit
+    std::size_t ResumedPixels() const;
+    // Distance of the pixel to the boundary of the set in pixels, zero for
+    // pixels that did not escape and without distance estimation
+    float Distance(std::uint32_t x, std::uint32_t y) const;
+    // The pixel escaped closer than a pixel to the boundary, or did not escape
+    // but a neighbour did. Its colour is not reliable at this resolution.
+    bool NeedsRefinement(std::uint32_t x, std::uint32_t y) const;
+    std::size_t RefinementPixels() const;
+    // Pixels of the last Render() that got sub-samples
+    std::size_t SupersampledPixels() const;
+    // Samples per pixel that Accumulate() has averaged, one before it
+    unsigned AccumulatedSamples() const;
+    const TileScheduler& Scheduler() const;
+    // Of the last frame, all zero when it was not rendered with perturbation
+    const PerturbationStats& DeepStats() const;
+    unsigned Threads() const;
+    EIsa Isa() const;
+
+private:
+    using InsideQuad = std::function<bool(std::uint32_t x, std::uint32_t y)>;
+    // Texture coordinates at fractional pixel positions of the frame
+    using SampleFunction = std::function<void(const double* x, const double* y, float* values, std::size_t count)>;
+
+    // Computes the pixels of the tile that need it, or subdivides it
+    void RenderTile(const Tile& tile, const InsideQuad& inside, const Subdivision::Evaluate& evaluate);
+    // Return the function for the sub-samples of the frame
+    SampleFunction RenderFloat(const View& view);
+    SampleFunction RenderPrecise(const View& view, EPrecision precision);
+    void RenderDeep(const View& view);
+
+    // Pixel (x, y) shows the same value as (mirrorX - x, y), (x, mirrorY - y)
+    // or both flipped, for each of the images
+    struct Symmetry
+    {
+        std::int64_t mirrorX { 0 };
+        std::int64_t mirrorY { 0 };
+        // Flipped columns and rows
+        std::vector<std::pair<bool, bool>> images;
+    };
+
+    Symmetry FindSymmetry(const View& view) const;
+    // Lowest index of the pixel and its images in the frame
+    std::size_t MirrorSource(const Symmetry& symmetry, std::uint32_t x, std::uint32_t y) const;
+    void SkipMirrored(const Symmetry& symmetry);
+    void CopyMirrored(const Symmetry& symmetry);
+
+    // Sets the states for a view that differs from the last one only by the
+    // iteration limit, false when it differs by more
+    bool ChangeIterations(const View& view, const Symmetry& symmetry);
+    // Moves the kept orbits with a pan of the frame
+    void MoveOrbits(std::int64_t dx, std::int64_t dy);
+    // Records the iterations of computed pixels and the orbits that stopped
+    // at the limit
+    void KeepOrbits(const std::size_t* indices, const float* results, const OrbitState& orbit, std::size_t count, int limit);
+    bool Reproject(const View& view);
+    // Last Render() had the same view and band
+    bool SameView(const View& view) const;
+    // Polls the cancel check in passes that may stop
+    bool Stopping();
+    // Leaves computePixels off the grid of the pass for the next ones
+    void DeferPixels(std::uint32_t spacing);
+    // Shows the pixels that the pass did not compute as blocks of the ones it did
+    void FillProvisional(std::uint32_t spacing);
+    void Resample(double ratio, double shiftX, double shiftY);
+
+    double ImageHeight() const;
+    // Distance of neighbouring pixels in kernel coordinates
+    double PixelSpacing(const View& view) const;
+    // KernelParams::interiorEpsilon for this view
+    double InteriorEpsilon(const View& view) const;
+    float* Values(std::uint32_t y);
+    // Kernel distances to pixels, or nullptr without distance estimation
+    float* Distances(std::uint32_t y);
+    void FindRefinement();
+    // Largest Contrast() of the colour of the pixel and its neighbours
+    int NeighbourContrast(std::uint32_t x, std::uint32_t y) const;
+    void ColorRows();
+    void BlendSamples();
+    void Supersample(const SampleFunction& sample);
+
+    // Value of pixels outside of the quad, which get the clear colour
+    static constexpr float background { -std::numeric_limits<float>::infinity() };
+    // Rows per job of the colouring and reprojection passes
+    static constexpr std::uint32_t jobRows { 16 };
+    // Pixels per kernel call
+    static constexpr std::size_t pixelBatch { 256 };
+    // Largest difference of the four values around a resampled pixel that is
+    // still shown provisionally, one texel of the default palette
+    static constexpr float reprojectTolerance { 1.0f / 1024.0f };
+    // Distance in pixels of two orbit points that counts as a cycle. Larger
+    // finds cycles sooner but takes exterior pixels next to the edge as interior.
+    static constexpr double interiorTolerance { 0.125 };
+    // Largest offset of the mirror from the pixel grid in pixels
+    static constexpr double symmetryTolerance { 1e-6 };
+    // Distance in pixels where the colours reach full brightness
+    static constexpr float shadeDistance { 4.0f };
+    // Largest difference of a colour channel between neighbouring pixels, or a
+    // pixel and its first sub-samples, that is not antialiased
+    static constexpr int supersampleContrast { 24 };
+    // Sub-samples taken of every antialiased pixel before deciding on the rest
+    static constexpr unsigned firstSamples { 4 };
+    // Antialiased pixels per job
+    static constexpr std::size_t samplesJob { 64 };
+    // Pixels between the computed ones in the first progressive pass
+    static constexpr std::uint32_t firstSpacing { 16 };
+    // Pixels per kernel call in passes that may stop
+    static constexpr std::size_t stopBatch { 64 };
+    // Accumulate() stops adding samples after this many
+    static constexpr unsigned maxAccumulated { 256 };
+
+    enum PixelState: std::uint8_t
+    {
+        exactPixel,
+        provisionalPixel,
+        computePixel,
+        // Copied from its mirror image after computing
+        mirrorPixel,
+        // Continues the orbit where it stopped
+        resumePixel,
+        // Computed by a later pass of a progressive render
+        deferredPixel
+    };
+
+    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<TileScheduler> scheduler;
+    std::unique_ptr<FrameBuffer> frame;
+    // Palette texture coordinate of every pixel of the frame, the shader value
+    // divided by the texture scale. Colouring is a separate pass over these.
+    std::vector<float> values;
+    std::vector<std::uint8_t> states;
+    // Exterior distance in pixels, only with distance estimation
+    std::vector<float> distances;
+    std::vector<std::uint8_t> refinement;
+
+    // Orbits that stopped at the iteration limit of the last frame without
+    // escaping, in no particular order
+    struct StoppedOrbits
+    {
+        std::vector<std::size_t> index;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> norm;
+        std::vector<float> sum;
+        std::vector<float> savedX;
+        std::vector<float> savedY;
+
+        void Clear()
+        {
+            index.clear();
+            x.clear();
+            y.clear();
+            norm.clear();
+            sum.clear();
+            savedX.clear();
+            savedY.clear();
+        }
+    };
+
+    // Iterations of every pixel computed by the orbit kernel and its orbit if
+    // it did not escape. Zero for pixels that were filled, copied, resampled
+    // or are outside, and empty when the last frame did not keep them.
+    std::vector<float> orbitIterations;
+    StoppedOrbits stoppedOrbits;
+    // The ones that resumePixels continue
+    StoppedOrbits resumedOrbits;
+    std::mutex orbitMutex;
+
+    // Antialiased pixel and how many of its maxSamples - 1 slots in
+    // sampleValues are used. Colouring averages them with the pixel.
+    struct SampledPixel
+    {
+        std::size_t index;
+        unsigned count;
+    };
+
+    std::vector<SampledPixel> sampledPixels;
+    std::vector<float> sampleValues;
+    std::unique_ptr<ColorMap> colorMap;
+
+    // Sub-samples of the last frame when it is complete
+    SampleFunction lastSample;
+    // Colour sums of the accumulated samples, three per pixel, and how many
+    // samples each chunk of jobRows rows has
+    std::vector<float> accumulation;
+    std::vector<unsigned> chunkSamples;
+    std::unique_ptr<BlueNoise> noiseX;
+    std::unique_ptr<BlueNoise> noiseY;
+
+    // Previous frame for reprojection
+    std::vector<float> previousValues;
+    std::vector<std::uint8_t> previousStates;
+    std::vector<float> previousIterations;
+    View lastView;
+    Band lastBand;
+    bool lastValid { false };
+
+    std::size_t computedPixels { 0 };
+    std::size_t provisionalPixels { 0 };
+    std::atomic<std::size_t> filledPixels { 0 };
+    std::size_t mirroredPixels { 0 };
+    std::size_t resumedPixels { 0 };
+    std::size_t refinementPixels { 0 };
+
+    // Of the next pass of the same view, zero when the last one was complete
+    std::uint32_t nextSpacing { 0 };
+    bool cancellable { false };
+    std::atomic<bool> cancelled { false };
+    std::function<bool()> cancelCheck;
+
+    // Pixels that the perturbation path has to redo with another reference
+    std::vector<std::uint8_t> glitched;
+
+    // Primary reference of the last deep frame, reused while the view stays the
+    // same, for example over the bands of one image
+    struct CachedReference
+    {
+        std::unique_ptr<ReferenceOrbit> orbit;
+        std::unique_ptr<BlaTable> bla;
+        EFractal fractal { EFractal::Unknown };
+        int iterations { 0 };
+        double maxDeltaC { 0.0 };
+    };
+
+    CachedReference cached;
+
+    PerturbationStats stats;
+    PrecisionLimits precisionLimits;
+    Band band;
+
+    EPrecision precision { EPrecision::Auto };
+
+    EIsa isa { EIsa::Scalar };
+    float paletteOffset { 0.0f };
+    bool useBla { true };
+    bool useReprojection { true };
+    bool useSymmetry { true };
+    bool useResume { true };
+    bool useProgressive { false };
+    bool useInterior { false };
+    bool useSubdivision { false };
+    bool subdivisionGuard { true };
+    bool useDistance { false };
+    unsigned maxSamples { 1 };
+    double sampleBudget { 0.0 };
+};
+
+} // fractalnova
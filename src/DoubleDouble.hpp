@@ -0,0 +1,149 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+// Unevaluated sums of doubles (Dekker, Knuth; Hida, Li and Bailey's QD library).
+// The error-free transformations are templates so that they work both for single
+// doubles and for Lanes. They need strict IEEE rounding of each operation: no
+// -ffast-math and no contraction into fused multiply-adds.
+
+namespace fractalnova {
+
+// s + e == a + b exactly
+template <typename T>
+inline T TwoSum(const T& a, const T& b, T& e)
+{
+    const T s = a + b;
+    const T bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+// Like TwoSum when |a| >= |b|
+template <typename T>
+inline T QuickTwoSum(const T& a, const T& b, T& e)
+{
+    const T s = a + b;
+    e = b - (s - a);
+    return s;
+}
+
+// hi + lo == a, both halves with 26 significant bits
+template <typename T>
+inline void Split(const T& a, T& hi, T& lo)
+{
+    const T t = T { 134217729.0 } * a; // 2^27 + 1
+    hi = t - (t - a);
+    lo = a - hi;
+}
+
+// p + e == a * b exactly
+template <typename T>
+inline T TwoProd(const T& a, const T& b, T& e)
+{
+    T ah, al, bh, bl;
+    Split(a, ah, al);
+    Split(b, bh, bl);
+
+    const T p = a * b;
+    e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+    return p;
+}
+
+// About 106 significant bits
+template <typename T>
+struct DoubleDouble
+{
+    DoubleDouble() = default;
+    DoubleDouble(const T& value): hi(value), lo(0.0) {}
+    DoubleDouble(const T& h, const T& l): hi(h), lo(l) {}
+
+    T hi;
+    T lo;
+};
+
+template <typename T>
+inline DoubleDouble<T> operator+(const DoubleDouble<T>& a, const DoubleDouble<T>& b)
+{
+    T t1, t2;
+    T s1 = TwoSum(a.hi, b.hi, t1);
+    const T s2 = TwoSum(a.lo, b.lo, t2);
+    t1 = t1 + s2;
+    s1 = QuickTwoSum(s1, t1, t1);
+    t1 = t1 + t2;
+    s1 = QuickTwoSum(s1, t1, t1);
+    return { s1, t1 };
+}
+
+template <typename T>
+inline DoubleDouble<T> operator-(const DoubleDouble<T>& a)
+{
+    return { -a.hi, -a.lo };
+}
+
+template <typename T>
+inline DoubleDouble<T> operator-(const DoubleDouble<T>& a, const DoubleDouble<T>& b)
+{
+    return a + (-b);
+}
+
+template <typename T>
+inline DoubleDouble<T> operator*(const DoubleDouble<T>& a, const DoubleDouble<T>& b)
+{
+    T e;
+    const T p = TwoProd(a.hi, b.hi, e);
+    e = e + (a.hi * b.lo + a.lo * b.hi);
+    T lo;
+    const T hi = QuickTwoSum(p, e, lo);
+    return { hi, lo };
+}
+
+template <typename T>
+inline DoubleDouble<T> Sqr(const DoubleDouble<T>& a)
+{
+    T e;
+    const T p = TwoProd(a.hi, a.hi, e);
+    e = e + T { 2.0 } * a.hi * a.lo + a.lo * a.lo;
+    T lo;
+    const T hi = QuickTwoSum(p, e, lo);
+    return { hi, lo };
+}
+
+// Exact
+template <typename T>
+inline DoubleDouble<T> Twice(const DoubleDouble<T>& a)
+{
+    return { a.hi + a.hi, a.lo + a.lo };
+}
+
+template <typename T>
+inline const T& Leading(const DoubleDouble<T>& a)
+{
+    return a.hi;
+}
+
+template <typename Mask, typename T>
+inline DoubleDouble<T> Select(const Mask& mask, const DoubleDouble<T>& a, const DoubleDouble<T>& b)
+{
+    return { Select(mask, a.hi, b.hi), Select(mask, a.lo, b.lo) };
+}
+
+} // fractalnova
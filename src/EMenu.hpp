@@ -33,6 +33,7 @@ enum class EMenu {
     ResetView,
     VSync,
     ToggleFullscreen,
+    DumpProfile,
     LogDetail,
     LogDebug,
     LogInfo,
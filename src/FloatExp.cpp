@@ -0,0 +1,75 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "FloatExp.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace fractalnova {
+
+FloatExp FloatExp::Parse(const std::string& text)
+{
+    // Split "1.5e-400" so that the exponent does not overflow strtod
+    const std::size_t e = text.find_first_of("eE");
+
+    char* end = nullptr;
+    const std::string mantissaText = text.substr(0, e);
+    const double m = strtod(mantissaText.c_str(), &end);
+
+    if (mantissaText.empty() || *end != '\0') {
+        throw std::runtime_error("Invalid number '" + text + "'");
+    }
+
+    long decimalExponent = 0;
+
+    if (e != std::string::npos) {
+        decimalExponent = strtol(text.c_str() + e + 1, &end, 10);
+
+        if (*end != '\0') {
+            throw std::runtime_error("Invalid number '" + text + "'");
+        }
+    }
+
+    // 10^n = 2^(n * log2(10)), split into integer and fractional powers of two
+    const double bits = static_cast<double>(decimalExponent) * 3.32192809488736234787;
+    const double whole = std::floor(bits);
+
+    return { m * std::exp2(bits - whole), static_cast<std::int64_t>(whole) };
+}
+
+std::string FloatExp::ToString() const
+{
+    if (mantissa == 0.0) {
+        return "0";
+    }
+
+    const double log10Value = std::log10(std::fabs(mantissa)) + static_cast<double>(exponent) * 0.30102999566398119521;
+    const double decimalExponent = std::floor(log10Value);
+    const double decimalMantissa = std::pow(10.0, log10Value - decimalExponent);
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%s%.3fe%+.0f", mantissa < 0.0 ? "-" : "", decimalMantissa, decimalExponent);
+
+    return buffer;
+}
+
+} // fractalnova
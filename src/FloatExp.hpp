@@ -0,0 +1,109 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace fractalnova {
+
+// Double mantissa with a separate exponent, for zoom levels and pixel deltas
+// that do not fit in the range of a double. value = mantissa * 2^exponent.
+class FloatExp
+{
+public:
+    FloatExp() = default;
+    FloatExp(const double value) { Set(value, 0); }
+    FloatExp(const double m, const std::int64_t e) { Set(m, e); }
+
+    static FloatExp Parse(const std::string& text);
+
+    double Mantissa() const { return mantissa; }
+    std::int64_t Exponent() const { return exponent; }
+
+    double ToDouble() const { return exponent > 2000 ? HUGE_VAL * mantissa : exponent < -2000 ? 0.0 * mantissa : std::ldexp(mantissa, static_cast<int>(exponent)); }
+    double Log2() const { return std::log2(std::fabs(mantissa)) + static_cast<double>(exponent); }
+    bool IsZero() const { return mantissa == 0.0; }
+    std::string ToString() const;
+
+    FloatExp operator*(const FloatExp& o) const { return { mantissa * o.mantissa, exponent + o.exponent }; }
+    FloatExp operator/(const FloatExp& o) const { return { mantissa / o.mantissa, exponent - o.exponent }; }
+    FloatExp operator-() const { FloatExp r = *this; r.mantissa = -mantissa; return r; }
+
+    FloatExp operator+(const FloatExp& o) const
+    {
+        if (mantissa == 0.0) {
+            return o;
+        }
+
+        if (o.mantissa == 0.0) {
+            return *this;
+        }
+
+        const std::int64_t shift = o.exponent - exponent;
+
+        // Beyond the precision of a double the smaller one vanishes
+        if (shift > 60) {
+            return o;
+        }
+
+        if (shift < -60) {
+            return *this;
+        }
+
+        return { mantissa + std::ldexp(o.mantissa, static_cast<int>(shift)), exponent };
+    }
+
+    FloatExp operator-(const FloatExp& o) const { return *this + (-o); }
+
+    bool operator<(const FloatExp& o) const { return Compare(o) < 0; }
+    bool operator>(const FloatExp& o) const { return Compare(o) > 0; }
+    bool operator<=(const FloatExp& o) const { return Compare(o) <= 0; }
+    bool operator>=(const FloatExp& o) const { return Compare(o) >= 0; }
+    bool operator==(const FloatExp& o) const { return Compare(o) == 0; }
+    bool operator!=(const FloatExp& o) const { return Compare(o) != 0; }
+
+private:
+    void Set(const double m, const std::int64_t e)
+    {
+        if (m == 0.0 || !std::isfinite(m)) {
+            mantissa = m;
+            exponent = 0;
+            return;
+        }
+
+        int shift;
+        mantissa = std::frexp(m, &shift);
+        exponent = e + shift;
+    }
+
+    int Compare(const FloatExp& o) const
+    {
+        const FloatExp d = *this - o;
+        return d.mantissa < 0.0 ? -1 : d.mantissa > 0.0 ? 1 : 0;
+    }
+
+    double mantissa { 0.0 };
+    std::int64_t exponent { 0 };
+};
+
+} // fractalnova
@@ -0,0 +1,62 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Fractal.hpp"
+#include "Logger.hpp"
+
+namespace fractalnova {
+
+FractalInfo GetFractalInfo(const EFractal fractal)
+{
+    constexpr Vertex mandelbrotScale { 3.5f, 2.0f };
+    constexpr Vertex juliaScale { 2.0f, 2.0f };
+
+    switch (fractal) {
+        case EFractal::Mandelbrot:
+            return { "mandelbrot", {}, mandelbrotScale };
+        case EFractal::Julia1:
+            return { "julia", { -0.618f, 0.0f }, juliaScale };
+        case EFractal::Julia2:
+            return { "julia", { -0.4f, 0.6f }, juliaScale };
+        case EFractal::Julia3:
+            return { "julia", { 0.285f, 0.0f }, juliaScale };
+        case EFractal::Julia4:
+            return { "julia", { 0.285f, 0.01f }, juliaScale };
+        case EFractal::Julia5:
+            return { "julia", { 0.45f, 0.1428f }, juliaScale };
+        case EFractal::Julia6:
+            return { "julia", { -0.70176f, 0.3842f }, juliaScale };
+        case EFractal::Julia7:
+            return { "julia", { -0.835f, 0.232f }, juliaScale };
+        case EFractal::Julia8:
+            return { "julia", { -0.8f, 0.156f }, juliaScale };
+        case EFractal::Julia9:
+            return { "julia", { -0.7269f, 0.1889f }, juliaScale };
+        case EFractal::Julia10:
+            return { "julia", { 0.0, -0.8f }, juliaScale };
+        default:
+            logging::Error("Unknown fractal %d", static_cast<int>(fractal));
+            break;
+    }
+
+    return {};
+}
+
+} // fractalnova
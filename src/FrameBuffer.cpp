@@ -0,0 +1,55 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "FrameBuffer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+
+namespace fractalnova {
+
+static const Color opaqueBlack { 0, 0, 0, 255 };
+
+FrameBuffer::FrameBuffer(const std::uint32_t width, const std::uint32_t height):
+    width(width),
+    height(height),
+    pixels(static_cast<std::size_t>(width) * height, opaqueBlack)
+{
+    logging::Debug("Create FrameBuffer of size %u * %u", width, height);
+}
+
+void FrameBuffer::Clear(const Color& color)
+{
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+void FrameBuffer::Enlarge(const FrameBuffer& source, const std::uint32_t factor)
+{
+    for (std::uint32_t y = 0; y < height; y++) {
+        const Color* from = source.Row(std::min(y / factor, source.Height() - 1));
+        Color* to = Row(y);
+
+        for (std::uint32_t x = 0; x < width; x++) {
+            to[x] = from[std::min(x / factor, source.Width() - 1)];
+        }
+    }
+}
+
+} // fractalnova
@@ -0,0 +1,55 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Palette.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fractalnova {
+
+// Plain RGBA framebuffer used by the CPU renderer
+class FrameBuffer
+{
+public:
+    FrameBuffer(std::uint32_t width, std::uint32_t height);
+
+    void Clear(const Color& color);
+    // Fill with source repeating every pixel factor * factor times, cropped
+    // to this size
+    void Enlarge(const FrameBuffer& source, std::uint32_t factor);
+
+    std::uint32_t Width() const { return width; }
+    std::uint32_t Height() const { return height; }
+    std::uint32_t BytesPerRow() const { return width * static_cast<std::uint32_t>(sizeof(Color)); }
+
+    Color* Row(std::uint32_t y) { return pixels.data() + static_cast<std::size_t>(y) * width; }
+    const Color* Row(std::uint32_t y) const { return pixels.data() + static_cast<std::size_t>(y) * width; }
+    const Color* Data() const { return pixels.data(); }
+
+private:
+    std::uint32_t width { 0 };
+    std::uint32_t height { 0 };
+    std::vector<Color> pixels;
+};
+
+} // fractalnova
@@ -0,0 +1,134 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "FrameGovernor.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace fractalnova {
+
+FrameGovernor::FrameGovernor(const double budget, const unsigned maxDivisor):
+    budget(budget)
+{
+    // From full quality to the cheapest. Resolution goes first, because fewer
+    // iterations also change the colours.
+    static constexpr Quality ladder[] { { 1, 0 }, { 2, 0 }, { 2, 1 }, { 4, 1 }, { 4, 2 } };
+
+    for (const Quality& q : ladder) {
+        if (budget <= 0.0 && !levels.empty()) {
+            break;
+        }
+
+        const Quality clamped { std::min(q.divisor, std::max(1u, maxDivisor)), q.iterationShift };
+
+        if (levels.empty() || levels.back().divisor != clamped.divisor || levels.back().iterationShift != clamped.iterationShift) {
+            levels.push_back(clamped);
+        }
+    }
+}
+
+double FrameGovernor::Cost(const std::size_t index) const
+{
+    // Relative to full quality, by pixels and iterations
+    const double divisor = static_cast<double>(levels[index].divisor);
+
+    return 1.0 / (divisor * divisor * static_cast<double>(1u << levels[index].iterationShift));
+}
+
+void FrameGovernor::Interact(const double now)
+{
+    lastInput = now;
+
+    if (!interacting) {
+        // Start one step better than the last interaction ended, so that the
+        // quality can also go up between interactions
+        interacting = true;
+        level = interactionLevel > 0 ? interactionLevel - 1 : 0;
+    }
+}
+
+void FrameGovernor::Measure(const double total, const double waited)
+{
+    const double seconds = std::max(0.0, total - waited);
+
+    if (!interacting || seconds <= budget) {
+        return;
+    }
+
+    // Only lower the quality during an interaction. Going back up at once would
+    // often cost a whole frame, for example when the resolution changes.
+    const std::size_t previous = level;
+
+    while (level + 1 < levels.size() && seconds * Cost(level) / Cost(previous) > budget) {
+        level++;
+    }
+
+    if (level != previous) {
+        logging::Detail("Frame took %.1f ms, divisor %u, iteration shift %u", seconds * 1000.0,
+            levels[level].divisor, levels[level].iterationShift);
+    }
+}
+
+bool FrameGovernor::Restore(const double now)
+{
+    if (!interacting || now - lastInput < restoreDelay) {
+        return false;
+    }
+
+    interacting = false;
+    interactionLevel = level;
+
+    const bool degraded = level > 0;
+    level = 0;
+
+    return degraded;
+}
+
+bool FrameGovernor::Interacting() const
+{
+    return interacting;
+}
+
+unsigned FrameGovernor::Divisor() const
+{
+    return levels[level].divisor;
+}
+
+int FrameGovernor::Iterations(const int requested) const
+{
+    return std::max(requested >> levels[level].iterationShift, std::min(requested, minIterations));
+}
+
+void FrameGovernor::Describe(char* buffer, const std::size_t size, const int requested) const
+{
+    if (budget <= 0.0) {
+        snprintf(buffer, size, "no budget");
+    } else if (level == 0) {
+        snprintf(buffer, size, "budget %.0f ms, full quality", budget * 1000.0);
+    } else if (Divisor() == 1) {
+        snprintf(buffer, size, "budget %.0f ms, %d iterations", budget * 1000.0, Iterations(requested));
+    } else {
+        snprintf(buffer, size, "budget %.0f ms, 1/%u size, %d iterations", budget * 1000.0, Divisor(), Iterations(requested));
+    }
+}
+
+} // fractalnova
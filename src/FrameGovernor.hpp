@@ -0,0 +1,77 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace fractalnova {
+
+// Lowers the render resolution and the iteration cap of interactive frames so
+// that they fit in a frame budget, and restores full quality once the input
+// has stopped. Times are in seconds.
+class FrameGovernor
+{
+public:
+    // Zero budget disables the governor. maxDivisor is the largest resolution
+    // divisor the render context supports.
+    FrameGovernor(double budget, unsigned maxDivisor);
+
+    // Input changed the view at the given time, the next frames are interactive
+    void Interact(double now);
+    // Cost of the frame that was just drawn. Time spent waiting for the vertical
+    // blank is left out, because lower quality would not shorten it.
+    void Measure(double total, double waited);
+    // Ends the interaction when there was no input for a while. True when
+    // the quality went up and the frame has to be drawn again.
+    bool Restore(double now);
+
+    bool Interacting() const;
+    unsigned Divisor() const;
+    int Iterations(int requested) const;
+
+    // Policy and current decision for the window title
+    void Describe(char* buffer, std::size_t size, int requested) const;
+
+    // Input has to stop this long before full quality is restored
+    static constexpr double restoreDelay { 0.25 };
+    // Iteration cap is not lowered below this
+    static constexpr int minIterations { 100 };
+
+private:
+    struct Quality
+    {
+        unsigned divisor;
+        unsigned iterationShift;
+    };
+
+    double Cost(std::size_t index) const;
+
+    std::vector<Quality> levels;
+    double budget { 0.0 };
+    double lastInput { 0.0 };
+    // Current level, and the level the last interaction ended with
+    std::size_t level { 0 };
+    std::size_t interactionLevel { 0 };
+    bool interacting { false };
+};
+
+} // fractalnova
@@ -24,6 +24,7 @@ freely, subject to the following restrictions:
 #include "EMenu.hpp"
 #include "AboutWindow.hpp"
 #include "Version.hpp"
+#include "Profiler.hpp"
 
 #include <proto/dos.h>
 #include <proto/exec.h>
@@ -99,6 +100,12 @@ Object* GuiWindow::CreateMenu()
                 MA_Toggle, TRUE,
                 MA_Selected, fullscreen,
                 TAG_DONE),
+            MA_AddChild, IIntuition->NewObject(nullptr, menuClass,
+                MA_Type, T_ITEM,
+                MA_Label, "Dump profile",
+                MA_ID, EMenu::DumpProfile,
+                MA_Disabled, !profiler::Enabled(),
+                TAG_DONE),
             MA_AddChild, IIntuition->NewObject(nullptr, "menuclass",
                 MA_Type, T_ITEM,
                 MA_Label, "Iterations",
@@ -373,6 +380,11 @@ uint32 GuiWindow::IdcmpHook(Hook* hook, APTR window __attribute__((unused)), Int
         case IDCMP_EXTENDEDMOUSE:
             thisPtr->HandleExtendedMouse(reinterpret_cast<struct IntuiWheelData *>(msg->IAddress));
             break;
+        case IDCMP_REFRESHWINDOW:
+            // Simple refresh window, the damaged part is only restored by blitting
+            // the frame again
+            thisPtr->Set(EFlag::Redraw);
+            break;
         default:
             logging::Error("Unknown message %lu", msg->Class);
             break;
@@ -537,7 +549,7 @@ void GuiWindow::CreateWindow()
         WA_InnerWidth, windowSize.width,
         WA_InnerHeight, windowSize.height,
         WA_Flags, WFLG_REPORTMOUSE | WFLG_NEWLOOKMENUS,
-        WA_IDCMP, /*IDCMP_REFRESHWINDOW |*/ IDCMP_NEWSIZE | IDCMP_CLOSEWINDOW | IDCMP_MOUSEBUTTONS | IDCMP_MOUSEMOVE |
+        WA_IDCMP, IDCMP_REFRESHWINDOW | IDCMP_NEWSIZE | IDCMP_CLOSEWINDOW | IDCMP_MOUSEBUTTONS | IDCMP_MOUSEMOVE |
                   IDCMP_DELTAMOVE | IDCMP_EXTENDEDMOUSE | IDCMP_RAWKEY | IDCMP_MENUPICK,
         WA_CloseGadget, !fullscreen,
         WA_DragBar, !fullscreen,
@@ -550,7 +562,7 @@ void GuiWindow::CreateWindow()
         WINDOW_Icon, MyGetDiskObject(),
         WINDOW_AppPort, appPort, // For Iconification
         WINDOW_IDCMPHook, &idcmpHook,
-        WINDOW_IDCMPHookBits, IDCMP_MOUSEBUTTONS | IDCMP_MOUSEMOVE | IDCMP_EXTENDEDMOUSE,
+        WINDOW_IDCMPHookBits, IDCMP_MOUSEBUTTONS | IDCMP_MOUSEMOVE | IDCMP_EXTENDEDMOUSE | IDCMP_REFRESHWINDOW,
         WINDOW_Position, WPOS_CENTERSCREEN,
         TAG_DONE);
 
@@ -593,8 +605,13 @@ void GuiWindow::DestroyWindow()
 GuiWindow::GuiWindow(const Params& params):
     vsync(params.vsync),
     fullscreen(params.fullscreen),
+    // Floats of the shaders run out of precision first, perturbation in CpuRenderer
+    // goes deeper but the window keeps zoom in a double
+    maxZoom(params.cpu ? 1e300 : 100000.0),
     screenSize(params.screenSize),
     windowSize(params.windowSize),
+    fractal(params.fractal),
+    palette(params.palette),
     iterations(params.iterations)
 {
     logging::Debug("Create GuiWindow");
@@ -618,28 +635,52 @@ GuiWindow::~GuiWindow()
     }
 }
 
+uint32 GuiWindow::WaitSignals() const
+{
+    uint32 winSig = 0;
+    if (!IIntuition->GetAttr(WINDOW_SigMask, windowObject, &winSig)) {
+        logging::Error("GetAttr failed on line %d", __LINE__);
+    }
+
+    return IExec->Wait(winSig | SIGBREAKF_CTRL_C);
+}
+
+void GuiWindow::WaitForInput()
+{
+    // Wait() consumes the signal, remember it for Run()
+    if (WaitSignals() & SIGBREAKF_CTRL_C) {
+        logging::Debug("Control-C while waiting");
+        breakSignal = true;
+    }
+}
+
+bool GuiWindow::InputPending() const
+{
+    return window && !IsMsgPortEmpty(window->UserPort);
+}
+
 bool GuiWindow::Run()
 {
     bool running { true };
 
-    position = { 0.0f, 0.0f };
+    position = { 0.0, 0.0 };
     flags.reset();
 
     if (!window) {
         // When iconified, wait for some event to save CPU
-        uint32 winSig = 0;
-        if (!IIntuition->GetAttr(WINDOW_SigMask, windowObject, &winSig)) {
-		    logging::Error("GetAttr failed on line %d", __LINE__);
-        }
-
-        const ULONG signals = IExec->Wait(winSig | SIGBREAKF_CTRL_C);
-
-        if (signals & SIGBREAKF_CTRL_C) {
+        if (WaitSignals() & SIGBREAKF_CTRL_C) {
             logging::Debug("Control-C while iconified");
             running = false;
         }
     }
 
+    PROFILE_ZONE(EStage::Events);
+
+    const EFractal oldFractal = fractal;
+    const EPalette oldPalette = palette;
+    const double oldZoom = zoom;
+    const int oldIterations = iterations;
+
     uint32 result;
     int16 code = 0;
 
@@ -678,7 +719,13 @@ bool GuiWindow::Run()
         CreateWindow();
     }
 
-    if (IExec->SetSignal(0, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C) {
+    if (flags.any() || position.x != 0.0 || position.y != 0.0 || fractal != oldFractal || palette != oldPalette ||
+        zoom != oldZoom || iterations != oldIterations)
+    {
+        Set(EFlag::Redraw);
+    }
+
+    if (breakSignal || (IExec->SetSignal(0, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C)) {
         logging::Debug("Control-C");
         running = false;
     }
@@ -732,6 +779,10 @@ bool GuiWindow::HandleMenuPick()
                 ToggleFullscreen();
                 break;
 
+            case EMenu::DumpProfile:
+                profiler::Dump();
+                break;
+
             case EMenu::Iterations100:
                 iterations = 100;
                 break;
@@ -860,8 +911,8 @@ void GuiWindow::HandleMouseButtons(UWORD code)
 void GuiWindow::HandleMouseMove(int mouseX, int mouseY)
 {
     if (panning) {
-        position.x += static_cast<float>(mouseX) / static_cast<float>(windowSize.width) / zoom;
-        position.y += static_cast<float>(mouseY) / static_cast<float>(windowSize.height) / zoom;
+        position.x += static_cast<double>(mouseX) / static_cast<double>(windowSize.width) / zoom;
+        position.y += static_cast<double>(mouseY) / static_cast<double>(windowSize.height) / zoom;
     }
 }
 
@@ -942,6 +993,8 @@ void GuiWindow::HandleUniconify()
     if (!window) {
         throw std::runtime_error("Failed to reopen window");
     }
+
+    Set(EFlag::Redraw);
 }
 
 void GuiWindow::SetTitle(const char* title)
@@ -953,20 +1006,18 @@ void GuiWindow::SetTitle(const char* title)
 
 void GuiWindow::ClearPosition()
 {
-    position = { 0.0f, 0.0f };
+    position = { 0.0, 0.0 };
 }
 
-float GuiWindow::GetZoomStep() const
+double GuiWindow::GetZoomStep() const
 {
-    constexpr float zoomStep { 1.01f };
+    constexpr double zoomStep { 1.01 };
 
-    return fastZoom ? 2.0f * zoomStep : zoomStep;
+    return fastZoom ? 2.0 * zoomStep : zoomStep;
 }
 
 void GuiWindow::ZoomIn()
 {
-    constexpr float maxZoom { 100000.0f };
-
     zoom *= GetZoomStep();
 
     if (zoom > maxZoom) {
@@ -977,7 +1028,7 @@ void GuiWindow::ZoomIn()
 
 void GuiWindow::ZoomOut()
 {
-    constexpr float minZoom { 1.0f };
+    constexpr double minZoom { 1.0 };
 
     zoom /= GetZoomStep();
 
@@ -989,7 +1040,7 @@ void GuiWindow::ZoomOut()
 
 void GuiWindow::ResetView()
 {
-    zoom = 1.0f;
+    zoom = 1.0;
     Set(EFlag::Reset);
 }
 
@@ -1010,9 +1061,13 @@ void GuiWindow::Clear(const EFlag flag)
 
 void GuiWindow::Draw(const BackBuffer* backBuffer) const
 {
+    PROFILE_ZONE(EStage::Blit);
+
     if (window) {
         if (vsync) {
+            const uint64 start = timer.GetTicks();
             IGraphics->WaitTOF();
+            vsyncTicks += timer.GetTicks() - start;
         }
 
         const std::uint32_t winw = window->Width - (window->BorderLeft + window->BorderRight);
@@ -1027,6 +1082,14 @@ void GuiWindow::Draw(const BackBuffer* backBuffer) const
     }
 }
 
+double GuiWindow::TakeVSyncWait()
+{
+    const double seconds = timer.TicksToSeconds(vsyncTicks);
+    vsyncTicks = 0;
+
+    return seconds;
+}
+
 void GuiWindow::ToggleMenuItem(const EMenu id, const bool state)
 {
     auto menu = reinterpret_cast<Object *>(window->MenuStrip);
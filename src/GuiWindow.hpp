@@ -25,6 +25,7 @@ freely, subject to the following restrictions:
 #include "EPalette.hpp"
 #include "Logger.hpp"
 #include "Params.hpp"
+#include "Timer.hpp"
 
 #include <proto/intuition.h>
 
@@ -37,6 +38,8 @@ enum class EFlag
     Resize,
     Reset,
     ToggleFullscreen,
+    // Something visible changed, or the window has to be painted again
+    Redraw,
     Last
 };
 
@@ -50,14 +53,20 @@ public:
     ~GuiWindow();
 
     bool Run();
+    // Sleep until there is input for Run() or Control-C
+    void WaitForInput();
+    // Input waits for Run(). Only peeks at the port, so any task may ask.
+    bool InputPending() const;
     void Draw(const BackBuffer* backBuffer) const;
+    // Seconds that Draw() waited for the vertical blank since the last call
+    double TakeVSyncWait();
 
     void SetTitle(const char* title);
 
-    Vertex GetPosition() const { return position; }
+    Vertex64 GetPosition() const { return position; }
     void ClearPosition();
 
-    float GetZoom() const { return zoom; }
+    double GetZoom() const { return zoom; }
     int GetIterations() const { return iterations; }
 
     uint32 Width() const { return windowSize.width; }
@@ -78,6 +87,7 @@ private:
     void DestroyWindow();
     Object* CreateMenu();
     void SetLimits() const;
+    uint32 WaitSignals() const;
 
     void HandleExtendedMouse(const struct IntuiWheelData* data);
     bool HandleMenuPick();
@@ -92,7 +102,7 @@ private:
 
     void ResetView();
 
-    float GetZoomStep() const;
+    double GetZoomStep() const;
     void ZoomIn();
     void ZoomOut();
 
@@ -113,9 +123,11 @@ private:
     bool fastZoom { false };
     bool vsync { false };
     bool fullscreen { false };
+    bool breakSignal { false };
 
-    Vertex position { };
-    float zoom { 1.0f };
+    Vertex64 position { };
+    double zoom { 1.0 };
+    double maxZoom { 1.0 };
 
     Resolution screenSize {};
     Resolution windowSize {};
@@ -126,6 +138,9 @@ private:
 
     std::bitset<static_cast<unsigned>(EFlag::Last)> flags;
     int iterations { 100 };
+
+    Timer timer;
+    mutable uint64 vsyncTicks { 0 };
 };
 
 } // fractalnova
@@ -0,0 +1,274 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "ImageWriter.hpp"
+#include "FrameBuffer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+namespace fractalnova {
+
+// Largest stored (uncompressed) deflate block
+static constexpr std::size_t maxStoredBlock { 65535 };
+
+static const std::array<std::uint32_t, 256>& CrcTable()
+{
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t {};
+
+        for (std::uint32_t n = 0; n < 256; n++) {
+            std::uint32_t c = n;
+
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+
+            t[n] = c;
+        }
+
+        return t;
+    }();
+
+    return table;
+}
+
+static std::uint32_t UpdateCrc(std::uint32_t crc, const std::uint8_t* data, const std::size_t size)
+{
+    const auto& table = CrcTable();
+
+    for (std::size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+static void PutBigEndian(std::uint8_t* out, const std::uint32_t value)
+{
+    out[0] = static_cast<std::uint8_t>(value >> 24);
+    out[1] = static_cast<std::uint8_t>(value >> 16);
+    out[2] = static_cast<std::uint8_t>(value >> 8);
+    out[3] = static_cast<std::uint8_t>(value);
+}
+
+ImageWriter::ImageWriter(const std::string& filename, const EImageFormat format, const std::uint32_t width, const std::uint32_t height):
+    format(format),
+    width(width),
+    height(height)
+{
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Empty image");
+    }
+
+    file = filename == "-" ? stdout : std::fopen(filename.c_str(), "wb");
+
+    if (!file) {
+        throw std::runtime_error("Failed to open " + filename);
+    }
+
+    logging::Debug("Write %s image of size %u * %u to %s", format == EImageFormat::Png ? "PNG" : "PPM", width, height, filename.c_str());
+
+    if (format == EImageFormat::Ppm) {
+        char header[64];
+        const int length = snprintf(header, sizeof(header), "P6\n%u %u\n255\n", width, height);
+        WriteBytes(header, static_cast<std::size_t>(length));
+        return;
+    }
+
+    static const std::uint8_t signature[] { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    WriteBytes(signature, sizeof(signature));
+
+    // 8-bit RGB, no interlacing
+    std::vector<std::uint8_t> header(13, 0);
+    PutBigEndian(&header[0], width);
+    PutBigEndian(&header[4], height);
+    header[8] = 8;
+    header[9] = 2;
+    WritePngChunk("IHDR", header);
+}
+
+ImageWriter::~ImageWriter()
+{
+    try {
+        Finish();
+    } catch (const std::exception& e) {
+        logging::Error("%s", e.what());
+    }
+
+    if (file && file != stdout) {
+        std::fclose(file);
+    }
+}
+
+EImageFormat ImageWriter::FormatFor(const std::string& filename)
+{
+    // Standard output has no name to go by
+    if (filename == "-") {
+        return EImageFormat::Png;
+    }
+
+    const std::size_t dot = filename.rfind('.');
+
+    if (dot != std::string::npos) {
+        std::string extension = filename.substr(dot + 1);
+
+        for (char& c: extension) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        if (extension == "png") {
+            return EImageFormat::Png;
+        }
+
+        if (extension == "ppm") {
+            return EImageFormat::Ppm;
+        }
+    }
+
+    throw std::runtime_error("Unsupported output format '" + filename + "', use .png or .ppm");
+}
+
+void ImageWriter::WriteRow(const Color* pixels)
+{
+    if (rows >= height) {
+        throw std::runtime_error("Too many image rows");
+    }
+
+    const std::size_t rgbBytes = static_cast<std::size_t>(width) * 3;
+
+    // PNG scanlines start with the filter type, 0 for none
+    const std::size_t start = format == EImageFormat::Png ? 1 : 0;
+
+    scanline.resize(start + rgbBytes);
+
+    if (start) {
+        scanline[0] = 0;
+    }
+
+    for (std::uint32_t x = 0; x < width; x++) {
+        scanline[start + 3 * x] = pixels[x].r;
+        scanline[start + 3 * x + 1] = pixels[x].g;
+        scanline[start + 3 * x + 2] = pixels[x].b;
+    }
+
+    if (format == EImageFormat::Ppm) {
+        WriteBytes(scanline.data(), scanline.size());
+        rows++;
+        return;
+    }
+
+    chunk.clear();
+
+    if (rows == 0) {
+        // zlib header: deflate, 32k window, no dictionary, fastest
+        chunk.push_back(0x78);
+        chunk.push_back(0x01);
+    }
+
+    for (std::size_t offset = 0; offset < scanline.size(); offset += maxStoredBlock) {
+        const std::size_t size = std::min(maxStoredBlock, scanline.size() - offset);
+        const std::uint16_t length = static_cast<std::uint16_t>(size);
+        const std::uint16_t inverted = static_cast<std::uint16_t>(~length);
+
+        chunk.push_back(0);
+        chunk.push_back(static_cast<std::uint8_t>(length));
+        chunk.push_back(static_cast<std::uint8_t>(length >> 8));
+        chunk.push_back(static_cast<std::uint8_t>(inverted));
+        chunk.push_back(static_cast<std::uint8_t>(inverted >> 8));
+        chunk.insert(chunk.end(), scanline.begin() + static_cast<std::ptrdiff_t>(offset), scanline.begin() + static_cast<std::ptrdiff_t>(offset + size));
+    }
+
+    for (const std::uint8_t byte: scanline) {
+        adlerA = (adlerA + byte) % 65521;
+        adlerB = (adlerB + adlerA) % 65521;
+    }
+
+    WritePngChunk("IDAT", chunk);
+    rows++;
+}
+
+void ImageWriter::Write(const FrameBuffer& frame)
+{
+    if (frame.Width() != width || frame.Height() != height) {
+        throw std::runtime_error("Frame does not match the image");
+    }
+
+    for (std::uint32_t y = rows; y < height; y++) {
+        WriteRow(frame.Row(y));
+    }
+}
+
+void ImageWriter::Finish()
+{
+    if (finished) {
+        return;
+    }
+
+    finished = true;
+
+    if (rows != height) {
+        throw std::runtime_error("Image is missing rows");
+    }
+
+    if (format == EImageFormat::Png) {
+        // Empty final block and the checksum close the zlib stream
+        std::vector<std::uint8_t> tail { 1, 0, 0, 0xff, 0xff, 0, 0, 0, 0 };
+        PutBigEndian(&tail[5], (adlerB << 16) | adlerA);
+        WritePngChunk("IDAT", tail);
+        WritePngChunk("IEND", {});
+    }
+
+    if (std::fflush(file) != 0) {
+        throw std::runtime_error("Failed to write image");
+    }
+}
+
+void ImageWriter::WriteBytes(const void* data, const std::size_t size)
+{
+    if (size && std::fwrite(data, 1, size, file) != size) {
+        throw std::runtime_error("Failed to write image");
+    }
+
+    bytesWritten += size;
+}
+
+void ImageWriter::WritePngChunk(const char* type, const std::vector<std::uint8_t>& data)
+{
+    std::uint8_t header[8];
+    PutBigEndian(header, static_cast<std::uint32_t>(data.size()));
+    std::memcpy(header + 4, type, 4);
+
+    std::uint32_t crc = UpdateCrc(0xffffffffu, header + 4, 4);
+    crc = UpdateCrc(crc, data.data(), data.size()) ^ 0xffffffffu;
+
+    std::uint8_t trailer[4];
+    PutBigEndian(trailer, crc);
+
+    WriteBytes(header, sizeof(header));
+    WriteBytes(data.data(), data.size());
+    WriteBytes(trailer, sizeof(trailer));
+}
+
+} // fractalnova
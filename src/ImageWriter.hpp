@@ -0,0 +1,77 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "EImageFormat.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace fractalnova {
+
+struct Color;
+class FrameBuffer;
+
+// Streams RGB rows into a binary PPM or an uncompressed PNG file. Only one
+// row is buffered at a time, so large images never need a second copy.
+// Filename "-" writes to the standard output.
+class ImageWriter
+{
+public:
+    ImageWriter(const std::string& filename, EImageFormat format, std::uint32_t width, std::uint32_t height);
+    ~ImageWriter();
+
+    ImageWriter(const ImageWriter&) = delete;
+    ImageWriter& operator=(const ImageWriter&) = delete;
+
+    // By the .png or .ppm extension, PNG for standard output. Throws on anything else.
+    static EImageFormat FormatFor(const std::string& filename);
+
+    void WriteRow(const Color* pixels);
+    void Write(const FrameBuffer& frame);
+    // Called by the destructor too, but only this one reports errors
+    void Finish();
+
+    std::uint64_t BytesWritten() const { return bytesWritten; }
+
+private:
+    void WriteBytes(const void* data, std::size_t size);
+    void WritePngChunk(const char* type, const std::vector<std::uint8_t>& data);
+
+    std::FILE* file { nullptr };
+    EImageFormat format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t rows { 0 };
+    bool finished { false };
+    std::uint64_t bytesWritten { 0 };
+
+    // One converted row and the PNG chunk built from it
+    std::vector<std::uint8_t> scanline;
+    std::vector<std::uint8_t> chunk;
+    // Adler-32 of the zlib stream inside the PNG
+    std::uint32_t adlerA { 1 };
+    std::uint32_t adlerB { 0 };
+};
+
+} // fractalnova
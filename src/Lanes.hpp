@@ -0,0 +1,166 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+namespace fractalnova {
+
+// Fixed size group of doubles with element-wise operators. Plain loops that the
+// compiler vectorizes for whatever the target has, so the extended precision
+// types can be written once for one value or for a group of pixels.
+template <unsigned N>
+struct Lanes
+{
+    static constexpr unsigned lanes { N };
+
+    Lanes() = default;
+    Lanes(const double value)
+    {
+        for (unsigned i = 0; i < N; i++) {
+            v[i] = value;
+        }
+    }
+
+    double& operator[](const unsigned i) { return v[i]; }
+    double operator[](const unsigned i) const { return v[i]; }
+
+    double v[N];
+};
+
+template <unsigned N>
+struct LaneMask
+{
+    bool v[N];
+};
+
+template <unsigned N>
+inline Lanes<N> operator+(const Lanes<N>& a, const Lanes<N>& b)
+{
+    Lanes<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] + b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline Lanes<N> operator-(const Lanes<N>& a, const Lanes<N>& b)
+{
+    Lanes<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] - b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline Lanes<N> operator*(const Lanes<N>& a, const Lanes<N>& b)
+{
+    Lanes<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] * b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline Lanes<N> operator-(const Lanes<N>& a)
+{
+    Lanes<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = -a.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline LaneMask<N> LessEqual(const Lanes<N>& a, const Lanes<N>& b)
+{
+    LaneMask<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] <= b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline LaneMask<N> Less(const Lanes<N>& a, const Lanes<N>& b)
+{
+    LaneMask<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] < b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline LaneMask<N> And(const LaneMask<N>& a, const LaneMask<N>& b)
+{
+    LaneMask<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = a.v[i] && b.v[i];
+    }
+
+    return r;
+}
+
+template <unsigned N>
+inline bool Any(const LaneMask<N>& mask)
+{
+    bool any = false;
+
+    for (unsigned i = 0; i < N; i++) {
+        any = any || mask.v[i];
+    }
+
+    return any;
+}
+
+template <unsigned N>
+inline Lanes<N> Select(const LaneMask<N>& mask, const Lanes<N>& a, const Lanes<N>& b)
+{
+    Lanes<N> r;
+
+    for (unsigned i = 0; i < N; i++) {
+        r.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+    }
+
+    return r;
+}
+
+inline double Select(const bool mask, const double a, const double b)
+{
+    return mask ? a : b;
+}
+
+} // fractalnova
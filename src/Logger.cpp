@@ -19,9 +19,14 @@ freely, subject to the following restrictions:
 */
 
 #include "Logger.hpp"
+
+#ifdef __amigaos4__
 #include "Buffer.hpp"
 
 #include <proto/exec.h>
+#else
+#include <vector>
+#endif
 
 #include <cstdarg>
 #include <cstdio>
@@ -63,9 +68,15 @@ static void LogImpl(const enum ELevel level, const char * fmt, va_list ap)
         vsnprintf(buffer, sizeof(buffer), fmt, ap);
         puts(buffer);
     } else {
+#ifdef __amigaos4__
         fractalnova::Buffer temp { len };
         vsnprintf(temp.Data(), len, fmt, ap);
         puts(temp.Data());
+#else
+        std::vector<char> temp(len);
+        vsnprintf(temp.data(), len, fmt, ap);
+        puts(temp.data());
+#endif
     }
 
     fflush(stdout);
@@ -20,12 +20,14 @@ freely, subject to the following restrictions:
 
 #include "NovaContext.hpp"
 #include "GuiWindow.hpp"
+#include "Fractal.hpp"
 #include "Palette.hpp"
 #include "Texture.hpp"
 #include "DataBuffer.hpp"
 #include "VertexBuffer.hpp"
 #include "Program.hpp"
 #include "BackBuffer.hpp"
+#include "Profiler.hpp"
 #include "Logger.hpp"
 #include "VertexBuffer.hpp"
 
@@ -148,8 +150,14 @@ void NovaContext::Clear() const
 
 void NovaContext::Draw() const
 {
-    program->UpdateVertexDBO();
-    program->UpdateFragmentDBO();
+    {
+        PROFILE_ZONE(EStage::Uniforms);
+
+        program->UpdateVertexDBO();
+        program->UpdateFragmentDBO();
+    }
+
+    PROFILE_ZONE(EStage::Draw);
 
     constexpr uint32 base = 0;
     const W3DN_ErrorCode errCode = context->DrawArrays(defaultRSO, W3DN_PRIM_TRISTRIP, base, vbo->vertexCount);
@@ -159,31 +167,41 @@ void NovaContext::Draw() const
 
 void NovaContext::SwapBuffers()
 {
-    W3DN_ErrorCode errCode;
+    {
+        PROFILE_ZONE(EStage::Submit);
 
-    const uint32 submitID = context->Submit(&errCode);
+        W3DN_ErrorCode errCode;
 
-    if (!submitID) {
-        ThrowOnError(errCode, "Submit failed");
-    }
+        const uint32 submitID = context->Submit(&errCode);
 
-    constexpr uint32 noTimeout = 0;
+        if (!submitID) {
+            ThrowOnError(errCode, "Submit failed");
+        }
 
-    errCode = context->WaitDone(submitID, noTimeout);
+        constexpr uint32 noTimeout = 0;
 
-    ThrowOnError(errCode, "WaitDone failed");
+        errCode = context->WaitDone(submitID, noTimeout);
+
+        ThrowOnError(errCode, "WaitDone failed");
+    }
 
     window.Draw(backBuffer.get());
 }
 
-void NovaContext::SetPosition(const Vertex& pos)
+bool NovaContext::Refining() const
 {
-    program->SetPosition(pos);
+    // Every Draw() is a complete frame
+    return false;
 }
 
-void NovaContext::SetZoom(const float z)
+void NovaContext::SetPosition(const Vertex64& pos)
 {
-    program->SetZoom(z);
+    program->SetPosition({ static_cast<float>(pos.x), static_cast<float>(pos.y) });
+}
+
+void NovaContext::SetZoom(const double z)
+{
+    program->SetZoom(static_cast<float>(z));
 }
 
 void NovaContext::SetIterations(const int iter)
@@ -192,6 +210,16 @@ void NovaContext::SetIterations(const int iter)
     program->SetIterations(iterations);
 }
 
+void NovaContext::SetResolutionDivisor(const unsigned divisor __attribute__((unused)))
+{
+    // The shaders always run at the window size
+}
+
+unsigned NovaContext::MaxResolutionDivisor() const
+{
+    return 1;
+}
+
 void NovaContext::Reset()
 {
     program->Reset();
@@ -209,61 +237,11 @@ void NovaContext::UseProgram(const EFractal fractal)
 
     current = fractal;
 
-    const char* name;
-    Vertex complex {};
-
-    switch (fractal) {
-        case EFractal::Mandelbrot:
-            name = "mandelbrot";
-            break;
-        case EFractal::Julia1:
-            name = "julia";
-            complex = { -0.618f, 0.0f };
-            break;
-        case EFractal::Julia2:
-            name = "julia";
-            complex = { -0.4f, 0.6f };
-            break;
-        case EFractal::Julia3:
-            name = "julia";
-            complex = { 0.285f, 0.0f };
-            break;
-        case EFractal::Julia4:
-            name = "julia";
-            complex = { 0.285f, 0.01f };
-            break;
-        case EFractal::Julia5:
-            name = "julia";
-            complex = { 0.45f, 0.1428f };
-            break;
-        case EFractal::Julia6:
-            name = "julia";
-            complex = { -0.70176f, 0.3842f };
-            break;
-        case EFractal::Julia7:
-            name = "julia";
-            complex = { -0.835f, 0.232f };
-            break;
-        case EFractal::Julia8:
-            name = "julia";
-            complex = { -0.8f, 0.156f };
-            break;
-        case EFractal::Julia9:
-            name = "julia";
-            complex = { -0.7269f, 0.1889f };
-            break;
-        case EFractal::Julia10:
-            name = "julia";
-            complex = { 0.0, -0.8f };
-            break;
-        default:
-            logging::Error("Unknown fractal %d", static_cast<int>(fractal));
-            break;
-    }
+    const FractalInfo info = GetFractalInfo(fractal);
 
     program.reset(); // Destroy old program first. Otherwise Program destructor removes ShaderPipeline afterwards!
-    program = std::make_unique<Program>(context, iterations, name);
-    program->SetComplex(complex);
+    program = std::make_unique<Program>(context, iterations, info.name);
+    program->SetComplex(info.complex);
 }
 
 void NovaContext::UsePalette(const EPalette palette)
@@ -21,8 +21,7 @@ freely, subject to the following restrictions:
 #pragma once
 
 #include "NovaObject.hpp"
-#include "EFractal.hpp"
-#include "EPalette.hpp"
+#include "RenderContext.hpp"
 
 #include <Warp3DNova/Context.h>
 
@@ -39,25 +38,28 @@ class Vertex;
 class Palette;
 class VertexBuffer;
 
-class NovaContext: public NovaObject
+class NovaContext: public NovaObject, public RenderContext
 {
 public:
 
     NovaContext(const GuiWindow& window, int iterations);
-    ~NovaContext();
-
-    void Resize();
-    void Clear() const;
-    void Draw() const;
-    void SwapBuffers();
-
-    void SetPosition(const Vertex& position);
-    void SetZoom(float zoom);
-    void SetIterations(int iterations);
-    void Reset();
-
-    void UseProgram(EFractal fractal);
-    void UsePalette(EPalette palette);
+    ~NovaContext() override;
+
+    void Resize() override;
+    void Clear() const override;
+    void Draw() const override;
+    void SwapBuffers() override;
+    bool Refining() const override;
+
+    void SetPosition(const Vertex64& position) override;
+    void SetZoom(double zoom) override;
+    void SetIterations(int iterations) override;
+    void SetResolutionDivisor(unsigned divisor) override;
+    unsigned MaxResolutionDivisor() const override;
+    void Reset() override;
+
+    void UseProgram(EFractal fractal) override;
+    void UsePalette(EPalette palette) override;
 
 private:
     void CloseLib();
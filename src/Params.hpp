@@ -20,7 +20,11 @@ freely, subject to the following restrictions:
 
 #pragma once
 
+#include "EFractal.hpp"
+#include "EPalette.hpp"
+
 #include <cstdint>
+#include <string>
 
 namespace fractalnova {
 
@@ -35,7 +39,24 @@ struct Params
     bool vsync { false };
     bool fullscreen { false };
     bool lazyClear { false };
+    bool cpu { false };
+    // CPU renderer stops early inside the set and colours it by period
+    bool interior { false };
+    // Samples per pixel that the CPU renderer averages while the view stays,
+    // up to one per frame. Below two it does not.
+    unsigned accumulate { 0 };
     int iterations { 100 };
+    unsigned threads { 0 };
+    // Milliseconds per interactive frame, zero keeps full quality
+    int frameBudget { 16 };
+
+    EFractal fractal { EFractal::Mandelbrot };
+    EPalette palette { EPalette::Rainbow };
+    // Centre on the complex plane and zoom as decimal strings, they may need
+    // more precision or range than a double has
+    std::string centreX { "0" };
+    std::string centreY { "0" };
+    std::string zoom { "1" };
 
     Resolution windowSize {};
     Resolution screenSize {};
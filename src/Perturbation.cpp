@@ -0,0 +1,229 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Perturbation.hpp"
+#include "BlaTable.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fractalnova {
+
+// Stop following the reference a bit after it has escaped
+static constexpr double referenceBailout { 4.0 };
+// Pauldelbrot's criterion: |z|^2 < tolerance * |Z|^2
+static constexpr double glitchTolerance { 1e-6 };
+// Leave headroom for squaring while staying clear of denormals
+static constexpr std::int64_t minDoubleExponent { -960 };
+
+ReferenceOrbit::ReferenceOrbit(const BigFloat& x, const BigFloat& y, const bool julia, const Vertex& complex, const int iterations):
+    x(x),
+    y(y)
+{
+    const unsigned limbs = x.FractionLimbs();
+
+    const BigFloat cx = julia ? BigFloat { static_cast<double>(complex.x), limbs } : x;
+    const BigFloat cy = julia ? BigFloat { static_cast<double>(complex.y), limbs } : y;
+
+    BigFloat zX = julia ? x : BigFloat { limbs };
+    BigFloat zY = julia ? y : BigFloat { limbs };
+
+    zx.reserve(static_cast<std::size_t>(iterations) + 2);
+    zy.reserve(static_cast<std::size_t>(iterations) + 2);
+
+    bool escaped = false;
+
+    for (int n = 0; n <= iterations; n++) {
+        const double dX = zX.ToDouble();
+        const double dY = zY.ToDouble();
+
+        zx.push_back(dX);
+        zy.push_back(dY);
+
+        // The shaders do one more step after escaping, keep that too
+        if (escaped) {
+            break;
+        }
+
+        escaped = dX * dX + dY * dY > referenceBailout;
+
+        const BigFloat xx = zX.Square();
+        const BigFloat yy = zY.Square();
+        const BigFloat xy = zX * zY;
+
+        zX = xx - yy + cx;
+        zY = xy.Twice() + cy;
+    }
+
+    logging::Detail("Reference orbit of %zu iterations, %u bits", zx.size(), limbs * 32);
+}
+
+bool FitsDouble(const FloatExp& spacing)
+{
+    return spacing.IsZero() || spacing.Exponent() > minDoubleExponent;
+}
+
+static double ToDouble(const double d)
+{
+    return d;
+}
+
+static double ToDouble(const FloatExp& d)
+{
+    return d.ToDouble();
+}
+
+// Cheap upper bound of |delta|
+template <typename T>
+static double Magnitude(const T& dx, const T& dy)
+{
+    return std::sqrt(2.0) * std::max(std::fabs(ToDouble(dx)), std::fabs(ToDouble(dy)));
+}
+
+template <typename T>
+static PerturbationResult PerturbImpl(const ReferenceOrbit& ref, const T startX, const T startY, const PerturbationParams& params)
+{
+    PerturbationResult result;
+
+    const std::size_t last = ref.Size() - 1;
+
+    // Mandelbrot: delta c is constant, delta z starts at 0. Julia: delta z starts at delta z0.
+    const T dcx = params.julia ? T { 0.0 } : startX;
+    const T dcy = params.julia ? T { 0.0 } : startY;
+
+    T dx = params.julia ? startX : T { 0.0 };
+    T dy = params.julia ? startY : T { 0.0 };
+
+    std::size_t m = 0;
+    int iteration = 0;
+    double norm = 0.0; // xx + yy of the shader
+
+    double zx = ref.Zx(0) + ToDouble(dx);
+    double zy = ref.Zy(0) + ToDouble(dy);
+
+    float sum = std::exp(-static_cast<float>(std::sqrt(zx * zx + zy * zy)));
+
+    bool skipping = params.bla != nullptr;
+
+    while (norm <= 4.0 && iteration < params.iterations) {
+        const BlaStep* step = nullptr;
+
+        if (skipping) {
+            const double magnitude = Magnitude(dx, dy);
+
+            // Deltas seldom shrink again before a rebase, stop looking once they are too large
+            if (magnitude < params.bla->MaxRadius()) {
+                step = params.bla->Find(m, magnitude, params.iterations - iteration);
+            } else {
+                skipping = false;
+            }
+        }
+
+        if (step) {
+            // delta' = A delta + B delta c
+            const T ndx = T { step->ax } * dx - T { step->ay } * dy + T { step->bx } * dcx - T { step->by } * dcy;
+            const T ndy = T { step->ax } * dy + T { step->ay } * dx + T { step->bx } * dcy + T { step->by } * dcx;
+
+            dx = ndx;
+            dy = ndy;
+            m += step->length;
+            iteration += static_cast<int>(step->length);
+            sum += step->sum;
+            result.skipped += step->length;
+
+            // The step is only valid while the orbit stays inside, so the one before
+            // the last is as good as the reference
+            norm = ref.Zx(m - 1) * ref.Zx(m - 1) + ref.Zy(m - 1) * ref.Zy(m - 1);
+        } else {
+            norm = zx * zx + zy * zy;
+
+            const double Zx = ref.Zx(m);
+            const double Zy = ref.Zy(m);
+
+            // delta' = 2 Z delta + delta^2 + delta c
+            const T twoZx { 2.0 * Zx };
+            const T twoZy { 2.0 * Zy };
+            const T ndx = twoZx * dx - twoZy * dy + (dx * dx - dy * dy) + dcx;
+            const T ndy = twoZx * dy + twoZy * dx + T { 2.0 } * dx * dy + dcy;
+
+            dx = ndx;
+            dy = ndy;
+            m++;
+            iteration++;
+        }
+
+        zx = ref.Zx(m) + ToDouble(dx);
+        zy = ref.Zy(m) + ToDouble(dy);
+
+        const double zNorm = zx * zx + zy * zy;
+
+        if (params.julia) {
+            sum += std::exp(-static_cast<float>(std::sqrt(zNorm)));
+
+            if (m == last && iteration < params.iterations && norm <= 4.0) {
+                // Reference escaped before this pixel, next step would run past its end
+                result.glitched = true;
+                break;
+            }
+
+            const double refNorm = ref.Zx(m) * ref.Zx(m) + ref.Zy(m) * ref.Zy(m);
+
+            if (zNorm < glitchTolerance * refNorm) {
+                result.glitched = true;
+                break;
+            }
+        } else {
+            const double dxd = ToDouble(dx);
+            const double dyd = ToDouble(dy);
+
+            if (m == last || zNorm < dxd * dxd + dyd * dyd) {
+                // Continue from the start of the orbit where Z is zero
+                dx = T { zx };
+                dy = T { zy };
+                m = 0;
+                result.rebases++;
+                skipping = params.bla != nullptr;
+            }
+        }
+    }
+
+    result.iterations = iteration;
+
+    if (params.julia) {
+        result.value = sum;
+    } else {
+        const float length = static_cast<float>(std::sqrt(zx * zx + zy * zy));
+        result.value = static_cast<float>(iteration) + 1.0f - std::log(std::log(length)) / std::log(2.0f);
+    }
+
+    return result;
+}
+
+PerturbationResult Perturb(const ReferenceOrbit& reference, const FloatExp& dx, const FloatExp& dy, const PerturbationParams& params)
+{
+    if (params.doubleDeltas) {
+        return PerturbImpl<double>(reference, dx.ToDouble(), dy.ToDouble(), params);
+    }
+
+    return PerturbImpl<FloatExp>(reference, dx, dy, params);
+}
+
+} // fractalnova
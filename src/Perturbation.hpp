@@ -0,0 +1,98 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "BigFloat.hpp"
+#include "FloatExp.hpp"
+#include "Vertex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fractalnova {
+
+class BlaTable;
+
+// High precision orbit of one point, stored as doubles for the pixel loops
+class ReferenceOrbit
+{
+public:
+    // x, y: c for Mandelbrot, z0 for Julia
+    ReferenceOrbit(const BigFloat& x, const BigFloat& y, bool julia, const Vertex& complex, int iterations);
+
+    std::size_t Size() const { return zx.size(); }
+    const BigFloat& X() const { return x; }
+    const BigFloat& Y() const { return y; }
+
+    double Zx(const std::size_t n) const { return zx[n]; }
+    double Zy(const std::size_t n) const { return zy[n]; }
+
+private:
+    BigFloat x;
+    BigFloat y;
+    std::vector<double> zx;
+    std::vector<double> zy;
+};
+
+struct PerturbationParams
+{
+    bool julia { false };
+    int iterations { 100 };
+    // Deltas in doubles or, beyond their exponent range, in FloatExp
+    bool doubleDeltas { true };
+    // Skips iterations when set, built from the same reference
+    const BlaTable* bla { nullptr };
+};
+
+struct PerturbationResult
+{
+    float value { 0.0f };
+    bool glitched { false };
+    unsigned rebases { 0 };
+    int iterations { 0 };
+    unsigned skipped { 0 };
+};
+
+// Totals of one frame
+struct PerturbationStats
+{
+    unsigned bits { 0 };
+    bool doubleDeltas { true };
+    unsigned references { 0 };
+    std::uint64_t pixels { 0 };
+    std::uint64_t iterations { 0 };
+    std::uint64_t skipped { 0 };
+    std::uint64_t rebases { 0 };
+    std::uint64_t glitches { 0 };
+};
+
+// Iterates the pixel at (reference + delta) as a small delta against the reference
+// orbit. Mandelbrot pixels rebase to the start of the orbit (Zhuoran) whenever the
+// delta grows larger than the full value or the reference runs out. Julia orbits
+// cannot rebase that way, so their pixels report glitches (Pauldelbrot) instead and
+// need to be redone against another reference.
+PerturbationResult Perturb(const ReferenceOrbit& reference, const FloatExp& dx, const FloatExp& dy, const PerturbationParams& params);
+
+// Whether deltas of this size can be iterated in plain doubles
+bool FitsDouble(const FloatExp& spacing);
+
+} // fractalnova
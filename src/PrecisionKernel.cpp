@@ -0,0 +1,422 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "PrecisionKernel.hpp"
+#include "Lanes.hpp"
+#include "DoubleDouble.hpp"
+#include "QuadDouble.hpp"
+#include "EscapeTime.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace fractalnova {
+
+namespace {
+
+// Pixels per block. Wide enough for AVX and still cheap to drag along when only
+// one pixel of the block keeps iterating.
+constexpr unsigned lanes { 4 };
+
+using Group = Lanes<lanes>;
+using DoubleDoubleGroup = DoubleDouble<Group>;
+using QuadDoubleGroup = QuadDouble<Group>;
+
+inline Group Sqr(const Group& a)
+{
+    return a * a;
+}
+
+inline Group Twice(const Group& a)
+{
+    return a + a;
+}
+
+inline const Group& Leading(const Group& a)
+{
+    return a;
+}
+
+// centre + offset
+template <typename Real>
+struct Coordinate;
+
+template <>
+struct Coordinate<Group>
+{
+    static Group Make(const double* centre, const Group& offset)
+    {
+        return Group { centre[0] } + (Group { centre[1] } + offset);
+    }
+};
+
+template <>
+struct Coordinate<DoubleDoubleGroup>
+{
+    static DoubleDoubleGroup Make(const double* centre, const Group& offset)
+    {
+        return DoubleDoubleGroup { centre[0], centre[1] } + DoubleDoubleGroup { offset };
+    }
+};
+
+template <>
+struct Coordinate<QuadDoubleGroup>
+{
+    static QuadDoubleGroup Make(const double* centre, const Group& offset)
+    {
+        return QuadDoubleGroup { centre[0], centre[1], centre[2], centre[3] } + QuadDoubleGroup { offset };
+    }
+};
+
+inline float Length(const Group& x, const Group& y, const unsigned i)
+{
+    const float fx = static_cast<float>(x[i]);
+    const float fy = static_cast<float>(y[i]);
+
+    return std::sqrt(fx * fx + fy * fy);
+}
+
+// Brent's cycle detection like in SimdKernelImpl.hpp. The pixels are closer
+// than the bits of a double, so the leading parts only rule out points that are
+// far apart and the rest are compared in full precision.
+template <typename Real>
+class CycleDetector
+{
+public:
+    // Leading parts of coordinates below 8 are off by at most 2^-50 each. Plain
+    // doubles are exact.
+    static constexpr double leadingError { std::is_same<Real, Group>::value ? 0.0 : 0x1p-48 };
+
+    CycleDetector(const Real& x, const Real& y, const double epsilon):
+        savedX(x), savedY(y), epsilon(epsilon * epsilon), reach((epsilon + leadingError) * (epsilon + leadingError))
+    {
+    }
+
+    void Step(const LaneMask<lanes>& active, const Real& x, const Real& y, Group& period)
+    {
+        step++;
+
+        const Group dx = Leading(x) - Leading(savedX);
+        const Group dy = Leading(y) - Leading(savedY);
+        auto found = And(active, LessEqual(dx * dx + dy * dy, reach));
+
+        if (leadingError > 0.0 && Any(found)) {
+            const Group fx = Leading(x - savedX);
+            const Group fy = Leading(y - savedY);
+            found = And(found, LessEqual(fx * fx + fy * fy, epsilon));
+        }
+
+        period = Select(found, Group { static_cast<double>(step - saved) }, period);
+
+        if ((step & (step - 1)) == 0) {
+            savedX = x;
+            savedY = y;
+            saved = step;
+        }
+    }
+
+private:
+    Real savedX;
+    Real savedY;
+    const Group epsilon;
+    const Group reach;
+    unsigned step { 0 };
+    unsigned saved { 0 };
+};
+
+// Main cardioid and the period 2 bulb, 1 or 2 where c is inside them. Evaluated
+// in full precision because deep views can be close to their edge.
+template <typename Real>
+Group KnownPeriod(const Real& cx, const Real& cy)
+{
+    const Real quarter { Group { 0.25 } };
+    const Real one { Group { 1.0 } };
+    const Group zero { 0.0 };
+
+    const Real cy2 = Sqr(cy);
+    const Real px = cx - quarter;
+    const Real q = Sqr(px) + cy2;
+    const Real bx = cx + one;
+
+    const auto cardioid = LessEqual(zero, Leading(quarter * cy2 - q * (q + px)));
+    const auto bulb = LessEqual(zero, Leading(Real { Group { 0.0625 } } - (Sqr(bx) + cy2)));
+
+    return Select(cardioid, Group { 1.0 }, Select(bulb, Group { 2.0 }, zero));
+}
+
+// Like in SimdKernelImpl.hpp. The derivative only needs the leading parts.
+inline void StoreDistance(float* distances, const Group& x, const Group& y, const Group& dx, const Group& dy, const Group& period,
+    const KernelParams& params)
+{
+    for (unsigned i = 0; i < lanes; i++) {
+        const double l = std::hypot(x[i], y[i]);
+        const float estimate = static_cast<float>(l * std::log(l) / std::hypot(dx[i], dy[i]) / params.distanceUnit);
+        distances[i] = l > 2.0 && period[i] <= 0.0 ? std::max(std::numeric_limits<float>::min(), estimate) : 0.0f;
+    }
+}
+
+// glsl/mandelbrot.frag
+template <typename Real, bool interior, bool distance>
+void MandelbrotBlock(const Real& cx, const Real& cy, float* values, float* distances, const KernelParams& params)
+{
+    const Group four { 4.0 };
+    const Group one { 1.0 };
+    const Group zero { 0.0 };
+    const Group limit { static_cast<double>(params.iterations) };
+
+    Real x { zero };
+    Real y { zero };
+    Group xx { zero };
+    Group yy { zero };
+    Group iteration { zero };
+
+    // dz/dc for the distance estimate
+    Group dx { zero };
+    Group dy { zero };
+
+    // Period of the lanes found inside the set, zero for the others
+    Group period { zero };
+
+    if (interior) {
+        period = KnownPeriod(cx, cy);
+    }
+
+    CycleDetector<Real> cycles { x, y, params.interiorEpsilon };
+
+    while (true) {
+        auto active = And(LessEqual(xx + yy, four), Less(iteration, limit));
+
+        if (interior) {
+            active = And(active, LessEqual(period, zero));
+        }
+
+        if (!Any(active)) {
+            break;
+        }
+
+        const Real nxx = Sqr(x);
+        const Real nyy = Sqr(y);
+        const Real xtemp = nxx - nyy + cx;
+        const Real ny = Twice(x * y) + cy;
+
+        if (distance) {
+            // dz' = 2 z dz + 1
+            const Group ndx = Twice(Leading(x) * dx - Leading(y) * dy) + one;
+            const Group ndy = Twice(Leading(x) * dy + Leading(y) * dx);
+
+            dx = Select(active, ndx, dx);
+            dy = Select(active, ndy, dy);
+        }
+
+        xx = Select(active, Leading(nxx), xx);
+        yy = Select(active, Leading(nyy), yy);
+        x = Select(active, xtemp, x);
+        y = Select(active, ny, y);
+        iteration = iteration + Select(active, one, zero);
+
+        if (interior) {
+            cycles.Step(active, x, y, period);
+        }
+    }
+
+    for (unsigned i = 0; i < lanes; i++) {
+        values[i] = period[i] > 0.0 ? InteriorValue(static_cast<float>(period[i])) :
+            static_cast<float>(iteration[i]) + 1.0f - std::log(std::log(Length(Leading(x), Leading(y), i))) / std::log(2.0f);
+    }
+
+    if (distance) {
+        StoreDistance(distances, Leading(x), Leading(y), dx, dy, period, params);
+    }
+}
+
+// glsl/julia.frag
+template <typename Real, bool interior, bool distance>
+void JuliaBlock(const Real& x0, const Real& y0, float* values, float* distances, const KernelParams& params)
+{
+    const Real cx { Group { static_cast<double>(params.complex.x) } };
+    const Real cy { Group { static_cast<double>(params.complex.y) } };
+    const Group four { 4.0 };
+    const Group one { 1.0 };
+    const Group zero { 0.0 };
+    const Group limit { static_cast<double>(params.iterations) };
+
+    Real x = x0;
+    Real y = y0;
+    Group xx { zero };
+    Group yy { zero };
+    Group iteration { zero };
+
+    for (unsigned i = 0; i < lanes; i++) {
+        values[i] = std::exp(-Length(Leading(x), Leading(y), i));
+    }
+
+    // dz/dz0 for the distance estimate
+    Group dx { one };
+    Group dy { zero };
+
+    Group period { zero };
+    CycleDetector<Real> cycles { x, y, params.interiorEpsilon };
+
+    while (true) {
+        auto active = And(LessEqual(xx + yy, four), Less(iteration, limit));
+
+        if (interior) {
+            active = And(active, LessEqual(period, zero));
+        }
+
+        if (!Any(active)) {
+            break;
+        }
+
+        const Real nxx = Sqr(x);
+        const Real nyy = Sqr(y);
+        const Real ny = Twice(x * y) + cy;
+        const Real nx = nxx - nyy + cx;
+
+        if (distance) {
+            // dz' = 2 z dz
+            const Group ndx = Twice(Leading(x) * dx - Leading(y) * dy);
+            const Group ndy = Twice(Leading(x) * dy + Leading(y) * dx);
+
+            dx = Select(active, ndx, dx);
+            dy = Select(active, ndy, dy);
+        }
+
+        xx = Select(active, Leading(nxx), xx);
+        yy = Select(active, Leading(nyy), yy);
+        x = Select(active, nx, x);
+        y = Select(active, ny, y);
+        iteration = iteration + Select(active, one, zero);
+
+        for (unsigned i = 0; i < lanes; i++) {
+            if (active.v[i]) {
+                values[i] += std::exp(-Length(Leading(nx), Leading(ny), i));
+            }
+        }
+
+        if (interior) {
+            cycles.Step(active, x, y, period);
+        }
+    }
+
+    for (unsigned i = 0; i < lanes; i++) {
+        if (period[i] > 0.0) {
+            values[i] = InteriorValue(static_cast<float>(period[i]));
+        }
+    }
+
+    if (distance) {
+        StoreDistance(distances, Leading(x), Leading(y), dx, dy, period, params);
+    }
+}
+
+template <typename Real, bool julia, bool interior, bool distance>
+void Block(const Real& x0, const Real& y0, float* values, float* distances, const KernelParams& params)
+{
+    if (julia) {
+        JuliaBlock<Real, interior, distance>(x0, y0, values, distances, params);
+    } else {
+        MandelbrotBlock<Real, interior, distance>(x0, y0, values, distances, params);
+    }
+}
+
+template <typename Real>
+using BlockFunction = void (*)(const Real&, const Real&, float*, float*, const KernelParams&);
+
+template <typename Real, bool julia>
+void Row(const PrecisionRow& row, float* values, float* distances, const unsigned count, const KernelParams& params)
+{
+    const bool interior = params.interiorEpsilon > 0.0;
+    const BlockFunction<Real> block = distances ?
+        (interior ? &Block<Real, julia, true, true> : &Block<Real, julia, false, true>) :
+        (interior ? &Block<Real, julia, true, false> : &Block<Real, julia, false, false>);
+
+    for (unsigned i = 0; i < count; i += lanes) {
+        // Pad the tail with copies of the last pixel
+        Group offsetX;
+        Group offsetY;
+
+        for (unsigned j = 0; j < lanes; j++) {
+            offsetX[j] = row.offsetX[std::min(i + j, count - 1)];
+            offsetY[j] = row.offsetY[std::min(i + j, count - 1)];
+        }
+
+        float blockValues[lanes];
+        float blockDistances[lanes];
+
+        block(Coordinate<Real>::Make(row.centreX, offsetX), Coordinate<Real>::Make(row.centreY, offsetY), blockValues, blockDistances, params);
+
+        for (unsigned j = 0; j < lanes && i + j < count; j++) {
+            values[i + j] = blockValues[j];
+
+            if (distances) {
+                distances[i + j] = blockDistances[j];
+            }
+        }
+    }
+}
+
+template <typename Real>
+PrecisionKernel GetKernel(const bool julia)
+{
+    return julia ? &Row<Real, true> : &Row<Real, false>;
+}
+
+} // anonymous
+
+const char* PrecisionName(const EPrecision precision)
+{
+    switch (precision) {
+        case EPrecision::Auto:
+            return "Auto";
+        case EPrecision::Float:
+            return "Float";
+        case EPrecision::Double:
+            return "Double";
+        case EPrecision::DoubleDouble:
+            return "Double-double";
+        case EPrecision::QuadDouble:
+            return "Quad-double";
+        case EPrecision::Perturbation:
+            return "Perturbation";
+    }
+
+    return "Unknown";
+}
+
+PrecisionKernel GetPrecisionKernel(const EPrecision precision, const bool julia)
+{
+    switch (precision) {
+        case EPrecision::Double:
+            return GetKernel<Group>(julia);
+        case EPrecision::DoubleDouble:
+            return GetKernel<DoubleDoubleGroup>(julia);
+        case EPrecision::QuadDouble:
+            return GetKernel<QuadDoubleGroup>(julia);
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+} // fractalnova
@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "EPrecision.hpp"
+#include "SimdKernel.hpp"
+
+namespace fractalnova {
+
+// A run of pixels as a common centre plus small offsets, one per pixel. The
+// centre is a sum of non-overlapping doubles, largest first, with as many bits
+// as the kernel needs.
+struct PrecisionRow
+{
+    double centreX[4];
+    double centreY[4];
+    const double* offsetX;
+    const double* offsetY;
+};
+
+// Escape-time kernel in double, double-double or quad-double precision. values
+// and distances are the same as from RowKernel.
+using PrecisionKernel = void (*)(const PrecisionRow& row, float* values, float* distances, unsigned count, const KernelParams& params);
+
+const char* PrecisionName(EPrecision precision);
+
+// nullptr for the precisions that are not rendered with these kernels
+PrecisionKernel GetPrecisionKernel(EPrecision precision, bool julia);
+
+} // fractalnova
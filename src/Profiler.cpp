@@ -0,0 +1,227 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Profiler.hpp"
+#include "Timer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+
+namespace fractalnova {
+
+namespace profiler {
+
+static constexpr std::array<const char*, static_cast<std::size_t>(EStage::Last)> stageNames {{
+    "frame",
+    "events",
+    "uniforms",
+    "draw",
+    "submit",
+    "blit",
+    "reproject",
+    "tile",
+    "reference",
+    "supersample",
+    "colorize",
+    "upload"
+}};
+
+const char* StageName(const EStage stage)
+{
+    return stageNames[static_cast<std::size_t>(stage)];
+}
+
+#ifdef PROFILING
+
+// Four buckets per octave of nanoseconds, up to 2^41 ns or about 36 minutes
+static constexpr unsigned subBuckets { 4 };
+static constexpr unsigned octaves { 41 };
+static constexpr unsigned bucketCount { octaves * subBuckets };
+// Threads beyond this are not profiled
+static constexpr unsigned maxThreads { 32 };
+
+static constexpr std::size_t stageCount { static_cast<std::size_t>(EStage::Last) };
+
+struct Histogram
+{
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> max;
+    std::atomic<std::uint64_t> buckets[bucketCount];
+};
+
+struct ThreadStats
+{
+    Histogram stages[stageCount];
+};
+
+static ThreadStats threadStats[maxThreads];
+static std::atomic<unsigned> threadCount { 0 };
+static std::atomic<std::uint64_t> dropped { 0 };
+
+static thread_local ThreadStats* local { nullptr };
+
+static const Timer& Clock()
+{
+    static const Timer timer;
+    return timer;
+}
+
+static unsigned Bucket(const std::uint64_t ns)
+{
+    if (ns < subBuckets) {
+        return static_cast<unsigned>(ns);
+    }
+
+    const unsigned octave = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+    const unsigned sub = static_cast<unsigned>(ns >> (octave - 2)) & (subBuckets - 1);
+
+    return std::min(octave * subBuckets + sub, bucketCount - 1);
+}
+
+// Upper end of the bucket
+static double BucketLimit(const unsigned bucket)
+{
+    if (bucket < subBuckets) {
+        return static_cast<double>(bucket + 1);
+    }
+
+    const unsigned octave = bucket / subBuckets;
+    const unsigned sub = bucket % subBuckets;
+
+    return static_cast<double>(std::uint64_t { subBuckets + sub + 1 } << (octave - 2));
+}
+
+static void Add(std::atomic<std::uint64_t>& counter, const std::uint64_t value)
+{
+    // Single writer
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+std::uint64_t Now()
+{
+    return Clock().GetTicks();
+}
+
+void Record(const EStage stage, const std::uint64_t ticks)
+{
+    if (!local) {
+        const unsigned index = threadCount++;
+
+        if (index >= maxThreads) {
+            dropped++;
+            return;
+        }
+
+        local = &threadStats[index];
+    }
+
+    const std::uint64_t ns = static_cast<std::uint64_t>(Clock().TicksToSeconds(ticks) * 1e9);
+    Histogram& h = local->stages[static_cast<std::size_t>(stage)];
+
+    Add(h.count, 1);
+    Add(h.total, ns);
+    Add(h.buckets[Bucket(ns)], 1);
+
+    if (ns > h.max.load(std::memory_order_relaxed)) {
+        h.max.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void Dump()
+{
+    const unsigned threads = std::min(threadCount.load(), maxThreads);
+
+    logging::Info("%-10s %8s %10s %9s %9s %9s %9s (ms, %u threads)", "stage", "count", "total", "p50", "p95", "p99", "max", threads);
+
+    for (std::size_t s = 0; s < stageCount; s++) {
+        std::uint64_t count = 0;
+        std::uint64_t total = 0;
+        std::uint64_t max = 0;
+        std::uint64_t buckets[bucketCount] {};
+
+        for (unsigned t = 0; t < threads; t++) {
+            const Histogram& h = threadStats[t].stages[s];
+
+            count += h.count.load(std::memory_order_relaxed);
+            total += h.total.load(std::memory_order_relaxed);
+            max = std::max(max, h.max.load(std::memory_order_relaxed));
+
+            for (unsigned b = 0; b < bucketCount; b++) {
+                buckets[b] += h.buckets[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        if (count == 0) {
+            continue;
+        }
+
+        // Percentiles are the upper end of their bucket, within 19 %
+        double percentiles[3] {};
+        const double fractions[3] { 0.50, 0.95, 0.99 };
+
+        for (unsigned p = 0; p < 3; p++) {
+            const std::uint64_t rank = static_cast<std::uint64_t>(fractions[p] * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen = 0;
+
+            for (unsigned b = 0; b < bucketCount; b++) {
+                seen += buckets[b];
+
+                if (seen >= rank) {
+                    percentiles[p] = std::min(BucketLimit(b), static_cast<double>(max));
+                    break;
+                }
+            }
+        }
+
+        logging::Info("%-10s %8" PRIu64 " %10.1f %9.3f %9.3f %9.3f %9.3f", stageNames[s], count,
+            static_cast<double>(total) / 1e6, percentiles[0] / 1e6, percentiles[1] / 1e6, percentiles[2] / 1e6,
+            static_cast<double>(max) / 1e6);
+    }
+
+    if (dropped > 0) {
+        logging::Info("%" PRIu64 " samples of threads past %u were dropped", dropped.load(), maxThreads);
+    }
+}
+
+#else
+
+std::uint64_t Now()
+{
+    return 0;
+}
+
+void Record(const EStage, const std::uint64_t)
+{
+}
+
+void Dump()
+{
+    logging::Info("Profiling is not compiled in, build with PROFILE=1");
+}
+
+#endif
+
+} // profiler
+
+} // fractalnova
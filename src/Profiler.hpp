@@ -0,0 +1,77 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "EStage.hpp"
+
+#include <cstdint>
+
+// Build with "make PROFILE=1" to compile the zones in. Otherwise they expand to
+// nothing and cost nothing.
+#ifdef PROFILING
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(stage) const fractalnova::profiler::Zone PROFILE_CONCAT(profileZone, __LINE__) { stage }
+#else
+#define PROFILE_ZONE(stage) static_cast<void>(0)
+#endif
+
+namespace fractalnova {
+
+namespace profiler {
+
+constexpr bool Enabled()
+{
+#ifdef PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* StageName(EStage stage);
+
+// Adds a sample to the histogram of the calling thread. Only the owning thread
+// writes its histograms, so no locks nor atomic read-modify-writes are needed.
+void Record(EStage stage, std::uint64_t ticks);
+std::uint64_t Now();
+
+// Logs count, total and p50 / p95 / p99 / max of every stage, merged over threads
+void Dump();
+
+// Measures its own lifetime
+class Zone
+{
+public:
+    explicit Zone(const EStage stage): stage(stage), start(Now()) {}
+    ~Zone() { Record(stage, Now() - start); }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    EStage stage;
+    std::uint64_t start;
+};
+
+} // profiler
+
+} // fractalnova
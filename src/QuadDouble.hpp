@@ -0,0 +1,163 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "DoubleDouble.hpp"
+
+namespace fractalnova {
+
+// a + b + c, rounded to two terms in a and b
+template <typename T>
+inline void ThreeSum(T& a, T& b, T& c)
+{
+    T t2, t3;
+    const T t1 = TwoSum(a, b, t2);
+    a = TwoSum(c, t1, t3);
+    b = TwoSum(t2, t3, c);
+}
+
+template <typename T>
+inline void ThreeSum2(T& a, T& b, const T& c)
+{
+    T t2, t3;
+    const T t1 = TwoSum(a, b, t2);
+    a = TwoSum(c, t1, t3);
+    b = t2 + t3;
+}
+
+// About 212 significant bits
+template <typename T>
+struct QuadDouble
+{
+    QuadDouble() = default;
+    QuadDouble(const T& value): x { value, 0.0, 0.0, 0.0 } {}
+    QuadDouble(const T& x0, const T& x1, const T& x2, const T& x3): x { x0, x1, x2, x3 } {}
+
+    T x[4];
+};
+
+// Five overlapping terms to four non-overlapping ones. Unlike the QD library
+// this skips the special cases for zero terms: no branches, so lanes stay in
+// step, for a tiny loss of precision when a term cancels out.
+template <typename T>
+inline QuadDouble<T> Renormalize(T c0, T c1, T c2, T c3, T c4)
+{
+    T s = QuickTwoSum(c3, c4, c4);
+    s = QuickTwoSum(c2, s, c3);
+    s = QuickTwoSum(c1, s, c2);
+    c0 = QuickTwoSum(c0, s, c1);
+
+    T e;
+    const T r0 = QuickTwoSum(c0, c1, e);
+    const T r1 = QuickTwoSum(e, c2, e);
+    const T r2 = QuickTwoSum(e, c3, e);
+    const T r3 = e + c4;
+
+    return { r0, r1, r2, r3 };
+}
+
+template <typename T>
+inline QuadDouble<T> operator+(const QuadDouble<T>& a, const QuadDouble<T>& b)
+{
+    T t0, t1, t2, t3;
+    const T s0 = TwoSum(a.x[0], b.x[0], t0);
+    T s1 = TwoSum(a.x[1], b.x[1], t1);
+    T s2 = TwoSum(a.x[2], b.x[2], t2);
+    T s3 = TwoSum(a.x[3], b.x[3], t3);
+
+    s1 = TwoSum(s1, t0, t0);
+    ThreeSum(s2, t0, t1);
+    ThreeSum2(s3, t0, t2);
+    t0 = t0 + t1 + t3;
+
+    return Renormalize(s0, s1, s2, s3, t0);
+}
+
+template <typename T>
+inline QuadDouble<T> operator-(const QuadDouble<T>& a)
+{
+    return { -a.x[0], -a.x[1], -a.x[2], -a.x[3] };
+}
+
+template <typename T>
+inline QuadDouble<T> operator-(const QuadDouble<T>& a, const QuadDouble<T>& b)
+{
+    return a + (-b);
+}
+
+// Terms below 2^-212 relative are dropped
+template <typename T>
+inline QuadDouble<T> operator*(const QuadDouble<T>& a, const QuadDouble<T>& b)
+{
+    T q0, q1, q2, q3, q4, q5;
+    const T p0 = TwoProd(a.x[0], b.x[0], q0);
+
+    T p1 = TwoProd(a.x[0], b.x[1], q1);
+    T p2 = TwoProd(a.x[1], b.x[0], q2);
+
+    T p3 = TwoProd(a.x[0], b.x[2], q3);
+    T p4 = TwoProd(a.x[1], b.x[1], q4);
+    T p5 = TwoProd(a.x[2], b.x[0], q5);
+
+    ThreeSum(p1, p2, q0);
+
+    // (p2, q1, q2) + (p3, p4, p5)
+    ThreeSum(p2, q1, q2);
+    ThreeSum(p3, p4, p5);
+
+    T t0, t1;
+    const T s0 = TwoSum(p2, p3, t0);
+    T s1 = TwoSum(q1, p4, t1);
+    T s2 = q2 + p5;
+    s1 = TwoSum(s1, t0, t0);
+    s2 = s2 + (t0 + t1);
+
+    s1 = s1 + (a.x[0] * b.x[3] + a.x[1] * b.x[2] + a.x[2] * b.x[1] + a.x[3] * b.x[0] + q0 + q3 + q4 + q5);
+
+    return Renormalize(p0, p1, s0, s1, s2);
+}
+
+template <typename T>
+inline QuadDouble<T> Sqr(const QuadDouble<T>& a)
+{
+    return a * a;
+}
+
+// Exact
+template <typename T>
+inline QuadDouble<T> Twice(const QuadDouble<T>& a)
+{
+    return { a.x[0] + a.x[0], a.x[1] + a.x[1], a.x[2] + a.x[2], a.x[3] + a.x[3] };
+}
+
+template <typename T>
+inline const T& Leading(const QuadDouble<T>& a)
+{
+    return a.x[0];
+}
+
+template <typename Mask, typename T>
+inline QuadDouble<T> Select(const Mask& mask, const QuadDouble<T>& a, const QuadDouble<T>& b)
+{
+    return { Select(mask, a.x[0], b.x[0]), Select(mask, a.x[1], b.x[1]), Select(mask, a.x[2], b.x[2]), Select(mask, a.x[3], b.x[3]) };
+}
+
+} // fractalnova
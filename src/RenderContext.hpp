@@ -0,0 +1,56 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "EFractal.hpp"
+#include "EPalette.hpp"
+
+namespace fractalnova {
+
+struct Vertex64;
+
+// Common interface of the GPU (Warp3D Nova) and the CPU render paths
+class RenderContext
+{
+public:
+    virtual ~RenderContext() = default;
+
+    virtual void Resize() = 0;
+    virtual void Clear() const = 0;
+    virtual void Draw() const = 0;
+    virtual void SwapBuffers() = 0;
+    // The last Draw() left work for the next one, which needs no new input
+    virtual bool Refining() const = 0;
+
+    virtual void SetPosition(const Vertex64& position) = 0;
+    virtual void SetZoom(double zoom) = 0;
+    virtual void SetIterations(int iterations) = 0;
+    // Render at 1/divisor of the window size and scale up, for keeping the frame
+    // rate. Divisors above MaxResolutionDivisor() are not supported.
+    virtual void SetResolutionDivisor(unsigned divisor) = 0;
+    virtual unsigned MaxResolutionDivisor() const = 0;
+    virtual void Reset() = 0;
+
+    virtual void UseProgram(EFractal fractal) = 0;
+    virtual void UsePalette(EPalette palette) = 0;
+};
+
+} // fractalnova
@@ -0,0 +1,223 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SimdKernel.hpp"
+#include "SimdKernelImpl.hpp"
+#include "Logger.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace fractalnova {
+
+RowKernel GetSse2Kernel(bool julia);
+RowKernel GetAvx2Kernel(bool julia);
+RowKernel GetAvx512Kernel(bool julia);
+RowKernel GetNeonKernel(bool julia);
+OrbitKernel GetSse2OrbitKernel(bool julia);
+OrbitKernel GetAvx2OrbitKernel(bool julia);
+OrbitKernel GetAvx512OrbitKernel(bool julia);
+OrbitKernel GetNeonOrbitKernel(bool julia);
+LaneKernel GetSse2LaneKernel(bool julia, bool refill);
+LaneKernel GetAvx2LaneKernel(bool julia, bool refill);
+LaneKernel GetAvx512LaneKernel(bool julia, bool refill);
+LaneKernel GetNeonLaneKernel(bool julia, bool refill);
+RowKernel GetSse2ChunkKernel(bool julia, unsigned block);
+RowKernel GetAvx2ChunkKernel(bool julia, unsigned block);
+RowKernel GetAvx512ChunkKernel(bool julia, unsigned block);
+RowKernel GetNeonChunkKernel(bool julia, unsigned block);
+
+namespace {
+
+struct ScalarOps
+{
+    using Float = float;
+    using Mask = bool;
+
+    static constexpr unsigned lanes { 1 };
+
+    static Float Load(const float* p) { return *p; }
+    static void Store(float* p, const Float a) { *p = a; }
+    static Float Set(const float a) { return a; }
+    static Float Add(const Float a, const Float b) { return a + b; }
+    static Float Sub(const Float a, const Float b) { return a - b; }
+    static Float Mul(const Float a, const Float b) { return a * b; }
+    static Float Sqrt(const Float a) { return std::sqrt(a); }
+    static Mask LessEqual(const Float a, const Float b) { return a <= b; }
+    static Mask Less(const Float a, const Float b) { return a < b; }
+    static Mask Greater(const Float a, const Float b) { return a > b; }
+    static Mask And(const Mask a, const Mask b) { return a && b; }
+    static bool Any(const Mask m) { return m; }
+    static bool All(const Mask m) { return m; }
+    static Float Select(const Mask m, const Float a, const Float b) { return m ? a : b; }
+    static Float Truncate(const Float a) { return static_cast<float>(static_cast<std::int32_t>(a)); }
+
+    static Float Pow2(const Float n)
+    {
+        const std::uint32_t bits = static_cast<std::uint32_t>(static_cast<std::int32_t>(n) + 127) << 23;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+};
+
+} // anonymous
+
+const char* IsaName(const EIsa isa)
+{
+    switch (isa) {
+        case EIsa::Scalar:
+            return "Scalar";
+        case EIsa::Sse2:
+            return "SSE2";
+        case EIsa::Avx2:
+            return "AVX2";
+        case EIsa::Avx512:
+            return "AVX-512";
+        case EIsa::Neon:
+            return "NEON";
+    }
+
+    return "Unknown";
+}
+
+static bool CpuSupports(const EIsa isa)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    switch (isa) {
+        case EIsa::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case EIsa::Avx2:
+            return __builtin_cpu_supports("avx2");
+        case EIsa::Avx512:
+            return __builtin_cpu_supports("avx512f");
+        default:
+            break;
+    }
+#endif
+
+    // Compiling NEON in implies that the target has it
+    return isa == EIsa::Scalar || isa == EIsa::Neon;
+}
+
+bool IsSupported(const EIsa isa)
+{
+    constexpr bool julia { false };
+
+    return GetRowKernel(isa, julia) && CpuSupports(isa);
+}
+
+std::vector<EIsa> SupportedIsas()
+{
+    std::vector<EIsa> isas;
+
+    for (auto isa: { EIsa::Scalar, EIsa::Sse2, EIsa::Avx2, EIsa::Avx512, EIsa::Neon }) {
+        if (IsSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+
+    return isas;
+}
+
+EIsa BestIsa()
+{
+    static const EIsa best = [] {
+        const EIsa isa = SupportedIsas().back();
+        logging::Debug("Using %s escape-time kernel", IsaName(isa));
+        return isa;
+    }();
+
+    return best;
+}
+
+RowKernel GetRowKernel(const EIsa isa, const bool julia)
+{
+    switch (isa) {
+        case EIsa::Scalar:
+            return simd::GetKernel<ScalarOps>(julia);
+        case EIsa::Sse2:
+            return GetSse2Kernel(julia);
+        case EIsa::Avx2:
+            return GetAvx2Kernel(julia);
+        case EIsa::Avx512:
+            return GetAvx512Kernel(julia);
+        case EIsa::Neon:
+            return GetNeonKernel(julia);
+    }
+
+    return nullptr;
+}
+
+OrbitKernel GetOrbitKernel(const EIsa isa, const bool julia)
+{
+    switch (isa) {
+        case EIsa::Scalar:
+            return simd::GetOrbitKernel<ScalarOps>(julia);
+        case EIsa::Sse2:
+            return GetSse2OrbitKernel(julia);
+        case EIsa::Avx2:
+            return GetAvx2OrbitKernel(julia);
+        case EIsa::Avx512:
+            return GetAvx512OrbitKernel(julia);
+        case EIsa::Neon:
+            return GetNeonOrbitKernel(julia);
+    }
+
+    return nullptr;
+}
+
+LaneKernel GetLaneKernel(const EIsa isa, const bool julia, const bool refill)
+{
+    switch (isa) {
+        case EIsa::Scalar:
+            return simd::GetLaneKernel<ScalarOps>(julia, refill);
+        case EIsa::Sse2:
+            return GetSse2LaneKernel(julia, refill);
+        case EIsa::Avx2:
+            return GetAvx2LaneKernel(julia, refill);
+        case EIsa::Avx512:
+            return GetAvx512LaneKernel(julia, refill);
+        case EIsa::Neon:
+            return GetNeonLaneKernel(julia, refill);
+    }
+
+    return nullptr;
+}
+
+RowKernel GetChunkKernel(const EIsa isa, const bool julia, const unsigned block)
+{
+    switch (isa) {
+        case EIsa::Scalar:
+            return simd::GetChunkKernel<ScalarOps>(julia, block);
+        case EIsa::Sse2:
+            return GetSse2ChunkKernel(julia, block);
+        case EIsa::Avx2:
+            return GetAvx2ChunkKernel(julia, block);
+        case EIsa::Avx512:
+            return GetAvx512ChunkKernel(julia, block);
+        case EIsa::Neon:
+            return GetNeonChunkKernel(julia, block);
+    }
+
+    return nullptr;
+}
+
+} // fractalnova
@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "Vertex.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fractalnova {
+
+enum class EIsa
+{
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512,
+    Neon
+};
+
+struct KernelParams
+{
+    int iterations { 100 };
+    Vertex complex {};
+    // Distance of two orbit points that counts as a cycle, about a pixel. Zero
+    // disables interior detection, which changes the values of interior pixels.
+    double interiorEpsilon { 0.0 };
+    // Unit of the distance estimates, the pixel spacing keeps deep ones in
+    // float range
+    double distanceUnit { 1.0 };
+};
+
+// Escape-time kernel for a run of pixels. x and y are the texture coordinates of
+// the shaders, values receive what the shaders pass to the palette lookup
+// (before dividing by TextureScale()). All ISAs produce identical bits.
+// With interior detection, pixels found inside the set get InteriorValue().
+// Unless distances is null, it receives the exterior distance estimate
+// |z| log |z| / |dz| in distanceUnit, zero for pixels that did not
+// escape. The derivative is taken with respect to c, or z0 for Julia and costs
+// six more operations per iteration.
+using RowKernel = void (*)(const float* x, const float* y, float* values, float* distances, unsigned count, const KernelParams& params);
+
+// Where the orbits of a run of pixels stopped: z, |z|^2 of the previous
+// iteration that the escape test uses, the iterations done, for Julia the sum
+// of the terms and the point that cycle detection compares with. Zero
+// iterations starts a new orbit and ignores the rest.
+struct OrbitState
+{
+    float* x;
+    float* y;
+    float* norm;
+    float* iterations;
+    float* sum;
+    float* savedX;
+    float* savedY;
+};
+
+// RowKernel without distances that continues the orbits up to the iteration
+// limit and leaves them in orbit. Starting from zero iterations, or from where
+// a lower limit stopped, gives the same values as RowKernel with this limit.
+// With interior detection that needs all pixels of a call to start from the
+// same number of iterations, because the cycle detection schedule is shared.
+using OrbitKernel = void (*)(const float* x, const float* y, float* values, const OrbitState& orbit, unsigned count, const KernelParams& params);
+
+// Lane iterations that advanced a pixel and all lane iterations run
+struct LaneUsage
+{
+    std::uint64_t used { 0 };
+    std::uint64_t total { 0 };
+
+    double Occupancy() const
+    {
+        return total > 0 ? static_cast<double>(used) / static_cast<double>(total) : 0.0;
+    }
+};
+
+// RowKernel that keeps the state of each lane in registers and, with refill,
+// gives a lane the next pixel as soon as its pixel is done instead of running
+// the vector until its slowest lane escapes. Same values as RowKernel. Without
+// refill the lanes run in blocks like RowKernel, which shows what the masked
+// loop wastes. The lane usage is added to usage unless it is null.
+using LaneKernel = void (*)(const float* x, const float* y, float* values, float* distances, unsigned count, const KernelParams& params,
+    LaneUsage* usage);
+
+// Block sizes of GetChunkKernel, 1 tests every iteration
+constexpr unsigned chunkBlocks[] { 1, 4, 8, 12, 16 };
+
+const char* IsaName(EIsa isa);
+
+// Compiled in and supported by this CPU
+bool IsSupported(EIsa isa);
+std::vector<EIsa> SupportedIsas();
+EIsa BestIsa();
+
+RowKernel GetRowKernel(EIsa isa, bool julia);
+OrbitKernel GetOrbitKernel(EIsa isa, bool julia);
+LaneKernel GetLaneKernel(EIsa isa, bool julia, bool refill);
+// RowKernel that iterates block times between the escape tests and repeats the
+// block one iteration at a time when a pixel escaped in it. Same values. The
+// RowKernel of the vector ISAs does this for Mandelbrot, and all use the masked
+// loop with interior detection. Null for other block sizes.
+RowKernel GetChunkKernel(EIsa isa, bool julia, unsigned block);
+
+} // fractalnova
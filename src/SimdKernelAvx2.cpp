@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SimdKernel.hpp"
+
+// Built with -mavx2 on x86 hosts
+#if defined(__AVX2__)
+
+#include "SimdKernelImpl.hpp"
+
+#include <immintrin.h>
+
+namespace fractalnova {
+namespace {
+
+struct Avx2Ops
+{
+    using Float = __m256;
+    using Mask = __m256;
+
+    static constexpr unsigned lanes { 8 };
+
+    static Float Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, const Float a) { _mm256_storeu_ps(p, a); }
+    static Float Set(const float a) { return _mm256_set1_ps(a); }
+    static Float Add(const Float a, const Float b) { return _mm256_add_ps(a, b); }
+    static Float Sub(const Float a, const Float b) { return _mm256_sub_ps(a, b); }
+    static Float Mul(const Float a, const Float b) { return _mm256_mul_ps(a, b); }
+    static Float Sqrt(const Float a) { return _mm256_sqrt_ps(a); }
+    static Mask LessEqual(const Float a, const Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask Less(const Float a, const Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask Greater(const Float a, const Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask And(const Mask a, const Mask b) { return _mm256_and_ps(a, b); }
+    static bool Any(const Mask m) { return _mm256_movemask_ps(m) != 0; }
+    static bool All(const Mask m) { return _mm256_movemask_ps(m) == 0xff; }
+    static Float Select(const Mask m, const Float a, const Float b) { return _mm256_blendv_ps(b, a, m); }
+    static Float Truncate(const Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static Float Pow2(const Float n) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23)); }
+};
+
+} // anonymous
+
+RowKernel GetAvx2Kernel(const bool julia)
+{
+    return simd::GetKernel<Avx2Ops>(julia);
+}
+
+OrbitKernel GetAvx2OrbitKernel(const bool julia)
+{
+    return simd::GetOrbitKernel<Avx2Ops>(julia);
+}
+
+LaneKernel GetAvx2LaneKernel(const bool julia, const bool refill)
+{
+    return simd::GetLaneKernel<Avx2Ops>(julia, refill);
+}
+
+RowKernel GetAvx2ChunkKernel(const bool julia, const unsigned block)
+{
+    return simd::GetChunkKernel<Avx2Ops>(julia, block);
+}
+
+} // fractalnova
+
+#else
+
+namespace fractalnova {
+
+RowKernel GetAvx2Kernel(bool)
+{
+    return nullptr;
+}
+
+OrbitKernel GetAvx2OrbitKernel(bool)
+{
+    return nullptr;
+}
+
+LaneKernel GetAvx2LaneKernel(bool, bool)
+{
+    return nullptr;
+}
+
+RowKernel GetAvx2ChunkKernel(bool, unsigned)
+{
+    return nullptr;
+}
+
+} // fractalnova
+
+#endif
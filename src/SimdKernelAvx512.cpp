@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SimdKernel.hpp"
+
+// Built with -mavx512f on x86 hosts
+#if defined(__AVX512F__)
+
+#include "SimdKernelImpl.hpp"
+
+#include <immintrin.h>
+
+namespace fractalnova {
+namespace {
+
+struct Avx512Ops
+{
+    using Float = __m512;
+    using Mask = __mmask16;
+
+    static constexpr unsigned lanes { 16 };
+
+    static Float Load(const float* p) { return _mm512_loadu_ps(p); }
+    static void Store(float* p, const Float a) { _mm512_storeu_ps(p, a); }
+    static Float Set(const float a) { return _mm512_set1_ps(a); }
+    static Float Add(const Float a, const Float b) { return _mm512_add_ps(a, b); }
+    static Float Sub(const Float a, const Float b) { return _mm512_sub_ps(a, b); }
+    static Float Mul(const Float a, const Float b) { return _mm512_mul_ps(a, b); }
+    static Float Sqrt(const Float a) { return _mm512_sqrt_ps(a); }
+    static Mask LessEqual(const Float a, const Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+    static Mask Less(const Float a, const Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static Mask Greater(const Float a, const Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+    static Mask And(const Mask a, const Mask b) { return static_cast<Mask>(a & b); }
+    static bool Any(const Mask m) { return m != 0; }
+    static bool All(const Mask m) { return m == 0xffff; }
+    static Float Select(const Mask m, const Float a, const Float b) { return _mm512_mask_blend_ps(m, b, a); }
+    static Float Truncate(const Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static Float Pow2(const Float n) { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvttps_epi32(n), _mm512_set1_epi32(127)), 23)); }
+};
+
+} // anonymous
+
+RowKernel GetAvx512Kernel(const bool julia)
+{
+    return simd::GetKernel<Avx512Ops>(julia);
+}
+
+OrbitKernel GetAvx512OrbitKernel(const bool julia)
+{
+    return simd::GetOrbitKernel<Avx512Ops>(julia);
+}
+
+LaneKernel GetAvx512LaneKernel(const bool julia, const bool refill)
+{
+    return simd::GetLaneKernel<Avx512Ops>(julia, refill);
+}
+
+RowKernel GetAvx512ChunkKernel(const bool julia, const unsigned block)
+{
+    return simd::GetChunkKernel<Avx512Ops>(julia, block);
+}
+
+} // fractalnova
+
+#else
+
+namespace fractalnova {
+
+RowKernel GetAvx512Kernel(bool)
+{
+    return nullptr;
+}
+
+OrbitKernel GetAvx512OrbitKernel(bool)
+{
+    return nullptr;
+}
+
+LaneKernel GetAvx512LaneKernel(bool, bool)
+{
+    return nullptr;
+}
+
+RowKernel GetAvx512ChunkKernel(bool, unsigned)
+{
+    return nullptr;
+}
+
+} // fractalnova
+
+#endif
@@ -0,0 +1,1026 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+// Escape-time kernels written once against a small vector abstraction. Each ISA
+// provides an Ops struct and instantiates the templates in its own translation
+// unit, compiled with the matching code generation flags. Keep everything here
+// a template so that no ISA specific code can leak into the other units.
+//
+// Ops interface:
+//   Float, Mask, lanes
+//   Load, Store, Set, Add, Sub, Mul, Sqrt, LessEqual, Less, Greater, And, Any, All,
+//   Select(mask, a, b), Truncate (round toward zero), Pow2 (2^n for integral n)
+
+#include "SimdKernel.hpp"
+#include "EscapeTime.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace fractalnova {
+namespace simd {
+
+template <typename Ops>
+inline typename Ops::Float Floor(const typename Ops::Float x)
+{
+    const auto t = Ops::Truncate(x);
+    return Ops::Select(Ops::Greater(t, x), Ops::Sub(t, Ops::Set(1.0f)), t);
+}
+
+// Cephes style expf. The shaders use exp() only in the Julia colouring.
+template <typename Ops>
+inline typename Ops::Float Exp(typename Ops::Float x)
+{
+    const auto lo = Ops::Set(-87.0f);
+    const auto hi = Ops::Set(88.0f);
+
+    x = Ops::Select(Ops::Less(x, lo), lo, x);
+    x = Ops::Select(Ops::Greater(x, hi), hi, x);
+
+    const auto n = Floor<Ops>(Ops::Add(Ops::Mul(x, Ops::Set(1.44269504088896341f)), Ops::Set(0.5f)));
+
+    x = Ops::Sub(x, Ops::Mul(n, Ops::Set(0.693359375f)));
+    x = Ops::Sub(x, Ops::Mul(n, Ops::Set(-2.12194440e-4f)));
+
+    const auto z = Ops::Mul(x, x);
+
+    auto y = Ops::Set(1.9875691500e-4f);
+    y = Ops::Add(Ops::Mul(y, x), Ops::Set(1.3981999507e-3f));
+    y = Ops::Add(Ops::Mul(y, x), Ops::Set(8.3334519073e-3f));
+    y = Ops::Add(Ops::Mul(y, x), Ops::Set(4.1665795894e-2f));
+    y = Ops::Add(Ops::Mul(y, x), Ops::Set(1.6666665459e-1f));
+    y = Ops::Add(Ops::Mul(y, x), Ops::Set(5.0000001201e-1f));
+    y = Ops::Add(Ops::Add(Ops::Mul(y, z), x), Ops::Set(1.0f));
+
+    return Ops::Mul(y, Ops::Pow2(n));
+}
+
+template <typename Ops>
+inline typename Ops::Float Length(const typename Ops::Float x, const typename Ops::Float y)
+{
+    return Ops::Sqrt(Ops::Add(Ops::Mul(x, x), Ops::Mul(y, y)));
+}
+
+// Brent's cycle detection. The orbit is saved at steps 1, 2, 4, 8... and every
+// later point is compared with the last saved one, which finds a cycle of any
+// period within twice the steps it takes to get close to it. Lanes that are still
+// active all are at the same step, so the schedule is shared by the block.
+template <typename Ops>
+class CycleDetector
+{
+public:
+    using Float = typename Ops::Float;
+    using Mask = typename Ops::Mask;
+
+    CycleDetector(const Float x, const Float y, const double epsilon):
+        savedX(x), savedY(y), epsilon(Ops::Set(static_cast<float>(epsilon * epsilon)))
+    {
+    }
+
+    // Continues the schedule where the orbit stopped, after as many steps as
+    // the first lane took. Lanes that did not start keep their first point.
+    void Continue(const OrbitState& orbit)
+    {
+        const auto started = Ops::Greater(Ops::Load(orbit.iterations), Ops::Set(0.0f));
+
+        savedX = Ops::Select(started, Ops::Load(orbit.savedX), savedX);
+        savedY = Ops::Select(started, Ops::Load(orbit.savedY), savedY);
+        step = static_cast<unsigned>(orbit.iterations[0]);
+        saved = step;
+
+        // Last power of two
+        while ((saved & (saved - 1)) != 0) {
+            saved &= saved - 1;
+        }
+    }
+
+    void Save(const OrbitState& orbit) const
+    {
+        Ops::Store(orbit.savedX, savedX);
+        Ops::Store(orbit.savedY, savedY);
+    }
+
+    // Sets the period of the active lanes whose orbit came back to the saved point
+    void Step(const Mask active, const Float x, const Float y, Float& period)
+    {
+        step++;
+
+        const auto dx = Ops::Sub(x, savedX);
+        const auto dy = Ops::Sub(y, savedY);
+        const auto found = Ops::And(active, Ops::LessEqual(Ops::Add(Ops::Mul(dx, dx), Ops::Mul(dy, dy)), epsilon));
+
+        period = Ops::Select(found, Ops::Set(static_cast<float>(step - saved)), period);
+
+        if ((step & (step - 1)) == 0) {
+            savedX = x;
+            savedY = y;
+            saved = step;
+        }
+    }
+
+private:
+    Float savedX;
+    Float savedY;
+    const Float epsilon;
+    unsigned step { 0 };
+    unsigned saved { 0 };
+};
+
+// |z| log |z| / |dz| of the lanes that escaped, zero for the others. Escaped
+// lanes whose derivative overflowed are still told apart by the smallest float.
+template <typename Ops>
+inline void StoreDistance(float* distances, const typename Ops::Float length, const typename Ops::Float dx, const typename Ops::Float dy,
+    const typename Ops::Float period, const KernelParams& params)
+{
+    const float unit = static_cast<float>(params.distanceUnit);
+
+    float l[Ops::lanes];
+    float d[Ops::lanes];
+    float p[Ops::lanes];
+
+    Ops::Store(l, length);
+    Ops::Store(d, Length<Ops>(dx, dy));
+    Ops::Store(p, period);
+
+    for (unsigned i = 0; i < Ops::lanes; i++) {
+        distances[i] = l[i] > 2.0f && p[i] <= 0.0f ? std::max(std::numeric_limits<float>::min(), l[i] * std::log(l[i]) / d[i] / unit) : 0.0f;
+    }
+}
+
+// Continues the lanes from where the orbit stopped. Lanes that did not start
+// keep the initial values.
+template <typename Ops>
+inline void LoadOrbit(const OrbitState& orbit, typename Ops::Float& x, typename Ops::Float& y, typename Ops::Float& norm,
+    typename Ops::Float& iteration, typename Ops::Float& sum)
+{
+    const auto n = Ops::Load(orbit.iterations);
+    const auto started = Ops::Greater(n, Ops::Set(0.0f));
+
+    x = Ops::Select(started, Ops::Load(orbit.x), x);
+    y = Ops::Select(started, Ops::Load(orbit.y), y);
+    norm = Ops::Select(started, Ops::Load(orbit.norm), norm);
+    iteration = n;
+    sum = Ops::Select(started, Ops::Load(orbit.sum), sum);
+}
+
+template <typename Ops>
+inline void StoreOrbit(const OrbitState& orbit, const typename Ops::Float x, const typename Ops::Float y, const typename Ops::Float norm,
+    const typename Ops::Float iteration, const typename Ops::Float sum)
+{
+    Ops::Store(orbit.x, x);
+    Ops::Store(orbit.y, y);
+    Ops::Store(orbit.norm, norm);
+    Ops::Store(orbit.iterations, iteration);
+    Ops::Store(orbit.sum, sum);
+}
+
+// glsl/mandelbrot.frag
+template <typename Ops, bool interior, bool distance, bool resume>
+inline void MandelbrotBlock(const float* x0, const float* y0, float* values, float* distances, const OrbitState* orbit,
+    const KernelParams& params)
+{
+    const auto cx = Ops::Load(x0);
+    const auto cy = Ops::Load(y0);
+    const auto two = Ops::Set(2.0f);
+    const auto four = Ops::Set(4.0f);
+    const auto zero = Ops::Set(0.0f);
+    const auto one = Ops::Set(1.0f);
+    const auto limit = Ops::Set(static_cast<float>(params.iterations));
+
+    auto x = zero;
+    auto y = zero;
+    auto xx = zero;
+    auto yy = zero;
+    auto iteration = zero;
+
+    // dz/dc for the distance estimate
+    auto dx = zero;
+    auto dy = zero;
+
+    // Period of the lanes found inside the set, zero for the others
+    auto period = zero;
+
+    if (interior) {
+        // Main cardioid and the period 2 bulb, where most interior pixels are
+        const auto quarter = Ops::Set(0.25f);
+        const auto px = Ops::Sub(cx, quarter);
+        const auto q = Ops::Add(Ops::Mul(px, px), Ops::Mul(cy, cy));
+        const auto cardioid = Ops::LessEqual(Ops::Mul(q, Ops::Add(q, px)), Ops::Mul(quarter, Ops::Mul(cy, cy)));
+        const auto bx = Ops::Add(cx, one);
+        const auto bulb = Ops::LessEqual(Ops::Add(Ops::Mul(bx, bx), Ops::Mul(cy, cy)), Ops::Set(0.0625f));
+
+        period = Ops::Select(bulb, two, period);
+        period = Ops::Select(cardioid, one, period);
+    }
+
+    if (resume) {
+        // Only the sum of the squares is tested
+        auto sum = zero;
+        LoadOrbit<Ops>(*orbit, x, y, xx, iteration, sum);
+    }
+
+    CycleDetector<Ops> cycles { x, y, params.interiorEpsilon };
+
+    if (resume) {
+        cycles.Continue(*orbit);
+    }
+
+    while (true) {
+        auto active = Ops::And(Ops::LessEqual(Ops::Add(xx, yy), four), Ops::Less(iteration, limit));
+
+        if (interior) {
+            active = Ops::And(active, Ops::LessEqual(period, zero));
+        }
+
+        if (!Ops::Any(active)) {
+            break;
+        }
+
+        const auto nxx = Ops::Mul(x, x);
+        const auto nyy = Ops::Mul(y, y);
+        const auto xtemp = Ops::Add(Ops::Sub(nxx, nyy), cx);
+        const auto ny = Ops::Add(Ops::Mul(Ops::Mul(two, x), y), cy);
+
+        if (distance) {
+            // dz' = 2 z dz + 1
+            const auto ndx = Ops::Add(Ops::Mul(two, Ops::Sub(Ops::Mul(x, dx), Ops::Mul(y, dy))), one);
+            const auto ndy = Ops::Mul(two, Ops::Add(Ops::Mul(x, dy), Ops::Mul(y, dx)));
+
+            dx = Ops::Select(active, ndx, dx);
+            dy = Ops::Select(active, ndy, dy);
+        }
+
+        xx = Ops::Select(active, nxx, xx);
+        yy = Ops::Select(active, nyy, yy);
+        x = Ops::Select(active, xtemp, x);
+        y = Ops::Select(active, ny, y);
+        iteration = Ops::Add(iteration, Ops::Select(active, one, zero));
+
+        if (interior) {
+            cycles.Step(active, x, y, period);
+        }
+    }
+
+    const auto length = Length<Ops>(x, y);
+
+    float l[Ops::lanes];
+    float n[Ops::lanes];
+    float p[Ops::lanes];
+
+    Ops::Store(l, length);
+    Ops::Store(n, iteration);
+    Ops::Store(p, period);
+
+    for (unsigned i = 0; i < Ops::lanes; i++) {
+        values[i] = p[i] > 0.0f ? InteriorValue(p[i]) : n[i] + 1.0f - std::log(std::log(l[i])) / std::log(2.0f);
+    }
+
+    if (distance) {
+        StoreDistance<Ops>(distances, length, dx, dy, period, params);
+    }
+
+    if (resume) {
+        StoreOrbit<Ops>(*orbit, x, y, Ops::Add(xx, yy), iteration, zero);
+        cycles.Save(*orbit);
+    }
+}
+
+// glsl/julia.frag
+template <typename Ops, bool interior, bool distance, bool resume>
+inline void JuliaBlock(const float* x0, const float* y0, float* values, float* distances, const OrbitState* orbit,
+    const KernelParams& params)
+{
+    const auto cx = Ops::Set(params.complex.x);
+    const auto cy = Ops::Set(params.complex.y);
+    const auto two = Ops::Set(2.0f);
+    const auto four = Ops::Set(4.0f);
+    const auto zero = Ops::Set(0.0f);
+    const auto one = Ops::Set(1.0f);
+    const auto limit = Ops::Set(static_cast<float>(params.iterations));
+
+    auto x = Ops::Load(x0);
+    auto y = Ops::Load(y0);
+    auto xx = zero;
+    auto yy = zero;
+    auto iteration = zero;
+
+    auto sum = Exp<Ops>(Ops::Sub(zero, Length<Ops>(x, y)));
+
+    if (resume) {
+        LoadOrbit<Ops>(*orbit, x, y, xx, iteration, sum);
+    }
+
+    // dz/dz0 for the distance estimate
+    auto dx = one;
+    auto dy = zero;
+
+    auto period = zero;
+    CycleDetector<Ops> cycles { x, y, params.interiorEpsilon };
+
+    if (resume) {
+        cycles.Continue(*orbit);
+    }
+
+    while (true) {
+        auto active = Ops::And(Ops::LessEqual(Ops::Add(xx, yy), four), Ops::Less(iteration, limit));
+
+        if (interior) {
+            active = Ops::And(active, Ops::LessEqual(period, zero));
+        }
+
+        if (!Ops::Any(active)) {
+            break;
+        }
+
+        const auto nxx = Ops::Mul(x, x);
+        const auto nyy = Ops::Mul(y, y);
+        const auto ny = Ops::Add(Ops::Mul(Ops::Mul(two, x), y), cy);
+        const auto nx = Ops::Add(Ops::Sub(nxx, nyy), cx);
+        const auto term = Exp<Ops>(Ops::Sub(zero, Length<Ops>(nx, ny)));
+
+        if (distance) {
+            // dz' = 2 z dz
+            const auto ndx = Ops::Mul(two, Ops::Sub(Ops::Mul(x, dx), Ops::Mul(y, dy)));
+            const auto ndy = Ops::Mul(two, Ops::Add(Ops::Mul(x, dy), Ops::Mul(y, dx)));
+
+            dx = Ops::Select(active, ndx, dx);
+            dy = Ops::Select(active, ndy, dy);
+        }
+
+        xx = Ops::Select(active, nxx, xx);
+        yy = Ops::Select(active, nyy, yy);
+        x = Ops::Select(active, nx, x);
+        y = Ops::Select(active, ny, y);
+        iteration = Ops::Add(iteration, Ops::Select(active, one, zero));
+        sum = Ops::Select(active, Ops::Add(sum, term), sum);
+
+        if (interior) {
+            cycles.Step(active, x, y, period);
+        }
+    }
+
+    if (resume) {
+        StoreOrbit<Ops>(*orbit, x, y, Ops::Add(xx, yy), iteration, sum);
+        cycles.Save(*orbit);
+    }
+
+    if (interior) {
+        sum = Ops::Select(Ops::Greater(period, zero), Ops::Sub(zero, period), sum);
+    }
+
+    Ops::Store(values, sum);
+
+    if (distance) {
+        StoreDistance<Ops>(distances, Length<Ops>(x, y), dx, dy, period, params);
+    }
+}
+
+template <typename Ops, bool julia, bool interior, bool distance, bool resume>
+inline void Block(const float* x0, const float* y0, float* values, float* distances, const OrbitState* orbit, const KernelParams& params)
+{
+    if (julia) {
+        JuliaBlock<Ops, interior, distance, resume>(x0, y0, values, distances, orbit, params);
+    } else {
+        MandelbrotBlock<Ops, interior, distance, resume>(x0, y0, values, distances, orbit, params);
+    }
+}
+
+using BlockFunction = void (*)(const float*, const float*, float*, float*, const OrbitState*, const KernelParams&);
+
+// Orbit state of the pixels from first on
+inline OrbitState Offset(const OrbitState& orbit, const unsigned first)
+{
+    return OrbitState {
+        orbit.x + first, orbit.y + first, orbit.norm + first, orbit.iterations + first, orbit.sum + first,
+        orbit.savedX + first, orbit.savedY + first
+    };
+}
+
+template <typename Ops>
+void Run(const BlockFunction block, const float* x, const float* y, float* values, float* distances, const OrbitState* orbit,
+    const unsigned count, const KernelParams& params)
+{
+    constexpr unsigned lanes = Ops::lanes;
+
+    unsigned i = 0;
+
+    for (; i + lanes <= count; i += lanes) {
+        if (orbit) {
+            const OrbitState part = Offset(*orbit, i);
+            block(x + i, y + i, values + i, nullptr, &part, params);
+        } else {
+            block(x + i, y + i, values + i, distances ? distances + i : nullptr, nullptr, params);
+        }
+    }
+
+    if (i < count) {
+        // Pad the tail with copies of the last pixel so that the extra lanes
+        // retire at the same time as the real ones
+        float tx[lanes];
+        float ty[lanes];
+        float tv[lanes];
+        float td[lanes];
+        float to[7][lanes];
+
+        for (unsigned j = 0; j < lanes; j++) {
+            const unsigned k = (i + j < count) ? i + j : count - 1;
+            tx[j] = x[k];
+            ty[j] = y[k];
+
+            if (orbit) {
+                to[0][j] = orbit->x[k];
+                to[1][j] = orbit->y[k];
+                to[2][j] = orbit->norm[k];
+                to[3][j] = orbit->iterations[k];
+                to[4][j] = orbit->sum[k];
+                to[5][j] = orbit->savedX[k];
+                to[6][j] = orbit->savedY[k];
+            }
+        }
+
+        const OrbitState tail { to[0], to[1], to[2], to[3], to[4], to[5], to[6] };
+
+        block(tx, ty, tv, td, orbit ? &tail : nullptr, params);
+
+        for (unsigned j = 0; i + j < count; j++) {
+            values[i + j] = tv[j];
+
+            if (distances) {
+                distances[i + j] = td[j];
+            }
+
+            if (orbit) {
+                orbit->x[i + j] = to[0][j];
+                orbit->y[i + j] = to[1][j];
+                orbit->norm[i + j] = to[2][j];
+                orbit->iterations[i + j] = to[3][j];
+                orbit->sum[i + j] = to[4][j];
+                orbit->savedX[i + j] = to[5][j];
+                orbit->savedY[i + j] = to[6][j];
+            }
+        }
+    }
+}
+
+// Calls step count times, unrolled
+template <unsigned count, typename Step>
+inline void Repeat(const Step& step)
+{
+    if constexpr (count > 0) {
+        step();
+        Repeat<count - 1>(step);
+    }
+}
+
+// MandelbrotBlock and JuliaBlock without interior detection that run block
+// iterations at a time without testing for escape. An orbit that has escaped
+// keeps growing, so testing after the block finds it. Then the block is
+// repeated from the saved state one iteration at a time, which gives the same
+// iterations and values as testing every iteration. Lanes that are done keep
+// their result and continue from zero, which never escapes, so no iteration
+// needs a mask.
+template <typename Ops, bool julia, bool distance, bool resume, unsigned block>
+inline void ChunkBlock(const float* x0, const float* y0, float* values, float* distances, const OrbitState* orbit,
+    const KernelParams& params)
+{
+    const auto two = Ops::Set(2.0f);
+    const auto four = Ops::Set(4.0f);
+    const auto zero = Ops::Set(0.0f);
+    const auto one = Ops::Set(1.0f);
+    const auto limit = Ops::Set(static_cast<float>(params.iterations));
+    // Last iteration where a block can start
+    const auto last = Ops::Set(static_cast<float>(params.iterations) - static_cast<float>(block));
+
+    auto cx = julia ? Ops::Set(params.complex.x) : Ops::Load(x0);
+    auto cy = julia ? Ops::Set(params.complex.y) : Ops::Load(y0);
+    auto x = julia ? Ops::Load(x0) : zero;
+    auto y = julia ? Ops::Load(y0) : zero;
+    auto xx = zero;
+    auto yy = zero;
+    auto iteration = zero;
+    auto dx = julia ? one : zero;
+    auto dy = zero;
+    auto sum = julia ? Exp<Ops>(Ops::Sub(zero, Length<Ops>(x, y))) : zero;
+
+    // Kept for the cycle detection of a later call with interior detection
+    auto savedX = x;
+    auto savedY = y;
+
+    if (resume) {
+        LoadOrbit<Ops>(*orbit, x, y, xx, iteration, sum);
+
+        const auto started = Ops::Greater(iteration, zero);
+
+        savedX = Ops::Select(started, Ops::Load(orbit->savedX), x);
+        savedY = Ops::Select(started, Ops::Load(orbit->savedY), y);
+    }
+
+    // Lanes that are not done, and the results of the others
+    auto live = one;
+    auto doneX = zero;
+    auto doneY = zero;
+    auto doneNorm = zero;
+    auto doneIteration = zero;
+    auto doneSum = zero;
+    auto doneDx = zero;
+    auto doneDy = zero;
+
+    const auto Iterate = [&] {
+        const auto nxx = Ops::Mul(x, x);
+        const auto nyy = Ops::Mul(y, y);
+        const auto nx = Ops::Add(Ops::Sub(nxx, nyy), cx);
+        const auto ny = Ops::Add(Ops::Mul(Ops::Mul(two, x), y), cy);
+
+        if (julia) {
+            sum = Ops::Add(sum, Exp<Ops>(Ops::Sub(zero, Length<Ops>(nx, ny))));
+        }
+
+        if (distance) {
+            // dz' = 2 z dz, plus 1 for Mandelbrot
+            const auto ndx = Ops::Mul(two, Ops::Sub(Ops::Mul(x, dx), Ops::Mul(y, dy)));
+            dy = Ops::Mul(two, Ops::Add(Ops::Mul(x, dy), Ops::Mul(y, dx)));
+            dx = julia ? ndx : Ops::Add(ndx, one);
+        }
+
+        xx = nxx;
+        yy = nyy;
+        x = nx;
+        y = ny;
+        iteration = Ops::Add(iteration, one);
+    };
+
+    // Iterations to repeat one at a time after a block found an escape
+    unsigned careful = 0;
+
+    while (true) {
+        const auto active = Ops::And(Ops::And(Ops::LessEqual(Ops::Add(xx, yy), four), Ops::Less(iteration, limit)),
+            Ops::Greater(live, zero));
+        const auto done = Ops::Greater(live, Ops::Select(active, one, zero));
+
+        if (Ops::Any(done)) {
+            doneX = Ops::Select(done, x, doneX);
+            doneY = Ops::Select(done, y, doneY);
+            doneNorm = Ops::Select(done, Ops::Add(xx, yy), doneNorm);
+            doneIteration = Ops::Select(done, iteration, doneIteration);
+            doneSum = Ops::Select(done, sum, doneSum);
+            doneDx = Ops::Select(done, dx, doneDx);
+            doneDy = Ops::Select(done, dy, doneDy);
+
+            live = Ops::Select(done, zero, live);
+            cx = Ops::Select(done, zero, cx);
+            cy = Ops::Select(done, zero, cy);
+            x = Ops::Select(done, zero, x);
+            y = Ops::Select(done, zero, y);
+            xx = Ops::Select(done, zero, xx);
+            yy = Ops::Select(done, zero, yy);
+            iteration = Ops::Select(done, zero, iteration);
+        }
+
+        if (!Ops::Any(active)) {
+            break;
+        }
+
+        if (careful == 0 && Ops::All(Ops::LessEqual(iteration, last))) {
+            const auto startX = x;
+            const auto startY = y;
+            const auto startXx = xx;
+            const auto startYy = yy;
+            const auto startIteration = iteration;
+            const auto startDx = dx;
+            const auto startDy = dy;
+            const auto startSum = sum;
+
+            Repeat<block>(Iterate);
+
+            // Also false for orbits that overflowed
+            if (Ops::All(Ops::LessEqual(Ops::Add(xx, yy), four))) {
+                continue;
+            }
+
+            x = startX;
+            y = startY;
+            xx = startXx;
+            yy = startYy;
+            iteration = startIteration;
+            dx = startDx;
+            dy = startDy;
+            sum = startSum;
+            careful = block;
+        }
+
+        Iterate();
+
+        if (careful > 0) {
+            careful--;
+        }
+    }
+
+    if (julia) {
+        Ops::Store(values, doneSum);
+    } else {
+        float l[Ops::lanes];
+        float n[Ops::lanes];
+
+        Ops::Store(l, Length<Ops>(doneX, doneY));
+        Ops::Store(n, doneIteration);
+
+        for (unsigned i = 0; i < Ops::lanes; i++) {
+            values[i] = n[i] + 1.0f - std::log(std::log(l[i])) / std::log(2.0f);
+        }
+    }
+
+    if (distance) {
+        StoreDistance<Ops>(distances, Length<Ops>(doneX, doneY), doneDx, doneDy, zero, params);
+    }
+
+    if (resume) {
+        StoreOrbit<Ops>(*orbit, doneX, doneY, doneNorm, doneIteration, doneSum);
+        Ops::Store(orbit->savedX, savedX);
+        Ops::Store(orbit->savedY, savedY);
+    }
+}
+
+// Block function of the row kernels that test for escape every block iterations
+template <typename Ops, bool julia, unsigned block>
+BlockFunction RowBlock(const bool interior, const bool distance)
+{
+    // Cycle detection compares every iteration
+    if (block == 1 || interior) {
+        return distance ?
+            (interior ? &Block<Ops, julia, true, true, false> : &Block<Ops, julia, false, true, false>) :
+            (interior ? &Block<Ops, julia, true, false, false> : &Block<Ops, julia, false, false, false>);
+    }
+
+    if constexpr (block > 1) {
+        return distance ? &ChunkBlock<Ops, julia, true, false, block> : &ChunkBlock<Ops, julia, false, false, block>;
+    }
+
+    return nullptr;
+}
+
+template <typename Ops, bool julia, unsigned block>
+void ChunkRow(const float* x, const float* y, float* values, float* distances, const unsigned count, const KernelParams& params)
+{
+    const BlockFunction function = RowBlock<Ops, julia, block>(params.interiorEpsilon > 0.0, distances != nullptr);
+
+    Run<Ops>(function, x, y, values, distances, nullptr, count, params);
+}
+
+// The Mandelbrot kernels of the vector ISAs test for escape every this many
+// iterations. Most Julia orbits escape within a few iterations, so their blocks
+// would mostly be repeated, and for scalar code the test is a well predicted
+// branch.
+constexpr unsigned rowChunk { 8 };
+
+template <typename Ops, bool julia>
+void Row(const float* x, const float* y, float* values, float* distances, const unsigned count, const KernelParams& params)
+{
+    constexpr unsigned block = !julia && Ops::lanes > 1 ? rowChunk : 1;
+
+    ChunkRow<Ops, julia, block>(x, y, values, distances, count, params);
+}
+
+template <typename Ops, bool julia>
+void OrbitRow(const float* x, const float* y, float* values, const OrbitState& orbit, const unsigned count, const KernelParams& params)
+{
+    const bool interior = params.interiorEpsilon > 0.0;
+    const BlockFunction block = interior ? &Block<Ops, julia, true, false, true> :
+        !julia && Ops::lanes > 1 ? &ChunkBlock<Ops, julia, false, true, rowChunk> : &Block<Ops, julia, false, false, true>;
+
+    Run<Ops>(block, x, y, values, nullptr, &orbit, count, params);
+}
+
+// Lanes of LaneRow that are done at an exchange
+template <unsigned lanes>
+struct DoneLanes
+{
+    float done[lanes];
+    float iteration[lanes];
+    float period[lanes];
+    float sum[lanes];
+    float length[lanes];
+    float derivative[lanes];
+};
+
+// Stores the results of the lanes that are done and gives them the next pixels.
+// pixel is count for an idle lane, fresh receives 1 for the lanes that got a
+// pixel and px, py its coordinates. Returns the iterations of the stored pixels.
+template <unsigned lanes, bool julia, bool interior, bool distance>
+std::uint64_t Exchange(const DoneLanes<lanes>& lane, unsigned* pixel, unsigned& next, float* fresh, float* px, float* py,
+    const float* x0, const float* y0, float* values, float* distances, const unsigned count, const KernelParams& params)
+{
+    const float unit = static_cast<float>(params.distanceUnit);
+
+    std::uint64_t used = 0;
+
+    for (unsigned i = 0; i < lanes; i++) {
+        fresh[i] = 0.0f;
+        px[i] = 0.0f;
+        py[i] = 0.0f;
+
+        if (lane.done[i] == 0.0f) {
+            continue;
+        }
+
+        if (pixel[i] < count) {
+            const unsigned k = pixel[i];
+            const float n = lane.iteration[i];
+            const float p = lane.period[i];
+            const float l = lane.length[i];
+
+            if (julia) {
+                values[k] = interior && p > 0.0f ? -p : lane.sum[i];
+            } else {
+                values[k] = p > 0.0f ? InteriorValue(p) : n + 1.0f - std::log(std::log(l)) / std::log(2.0f);
+            }
+
+            if (distance) {
+                distances[k] = l > 2.0f && p <= 0.0f ? std::max(std::numeric_limits<float>::min(), l * std::log(l) / lane.derivative[i] / unit) : 0.0f;
+            }
+
+            used += static_cast<std::uint64_t>(n);
+            pixel[i] = count;
+        }
+
+        if (next < count) {
+            pixel[i] = next;
+            fresh[i] = 1.0f;
+            px[i] = x0[next];
+            py[i] = y0[next];
+            next++;
+        }
+    }
+
+    return used;
+}
+
+// Escape-time loop of the lane kernels. The lanes work on different pixels,
+// each at its own iteration, so cycle detection keeps the schedule per lane.
+// Lanes of pixels that are done, and idle lanes, are inactive. They are
+// exchanged outside of the iteration loop, where the state stays in registers.
+template <typename Ops, bool julia, bool interior, bool distance, bool refill>
+void LaneRow(const float* x0, const float* y0, float* values, float* distances, const unsigned count, const KernelParams& params,
+    LaneUsage* usage)
+{
+    constexpr unsigned lanes = Ops::lanes;
+
+    const auto two = Ops::Set(2.0f);
+    const auto four = Ops::Set(4.0f);
+    const auto zero = Ops::Set(0.0f);
+    const auto one = Ops::Set(1.0f);
+    const auto limit = Ops::Set(static_cast<float>(params.iterations));
+    const auto epsilon = Ops::Set(static_cast<float>(params.interiorEpsilon * params.interiorEpsilon));
+
+    // c of Mandelbrot, the constant of Julia
+    auto cx = Ops::Set(params.complex.x);
+    auto cy = Ops::Set(params.complex.y);
+
+    auto x = zero;
+    auto y = zero;
+    auto xx = zero;
+    auto yy = zero;
+    // Idle lanes are at the limit
+    auto iteration = limit;
+    auto dx = zero;
+    auto dy = zero;
+    auto sum = zero;
+    auto period = zero;
+
+    // Brent's cycle detection: the saved point, the iteration it was saved at
+    // and the next one to save at
+    auto savedX = zero;
+    auto savedY = zero;
+    auto savedAt = zero;
+    auto nextSave = one;
+
+    unsigned pixel[lanes];
+    std::fill(pixel, pixel + lanes, count);
+
+    unsigned next = 0;
+    std::uint64_t steps = 0;
+    std::uint64_t used = 0;
+
+    while (true) {
+        auto active = Ops::And(Ops::LessEqual(Ops::Add(xx, yy), four), Ops::Less(iteration, limit));
+
+        if (interior) {
+            active = Ops::And(active, Ops::LessEqual(period, zero));
+        }
+
+        const bool idle = !Ops::Any(active);
+
+        if (idle || (refill && next < count && !Ops::All(active))) {
+            DoneLanes<lanes> lane;
+            float fresh[lanes];
+            float px[lanes];
+            float py[lanes];
+
+            Ops::Store(lane.done, Ops::Select(active, zero, one));
+            Ops::Store(lane.iteration, iteration);
+            Ops::Store(lane.period, period);
+
+            if (julia) {
+                Ops::Store(lane.sum, sum);
+            }
+
+            if (!julia || distance) {
+                Ops::Store(lane.length, Length<Ops>(x, y));
+            }
+
+            if (distance) {
+                Ops::Store(lane.derivative, Length<Ops>(dx, dy));
+            }
+
+            used += Exchange<lanes, julia, interior, distance>(lane, pixel, next, fresh, px, py, x0, y0, values, distances, count, params);
+
+            const auto started = Ops::Greater(Ops::Load(fresh), zero);
+
+            if (!Ops::Any(started)) {
+                if (idle) {
+                    break;
+                }
+
+                continue;
+            }
+
+            if (julia) {
+                x = Ops::Select(started, Ops::Load(px), x);
+                y = Ops::Select(started, Ops::Load(py), y);
+                sum = Ops::Select(started, Exp<Ops>(Ops::Sub(zero, Length<Ops>(x, y))), sum);
+                dx = Ops::Select(started, one, dx);
+            } else {
+                cx = Ops::Select(started, Ops::Load(px), cx);
+                cy = Ops::Select(started, Ops::Load(py), cy);
+                x = Ops::Select(started, zero, x);
+                y = Ops::Select(started, zero, y);
+                dx = Ops::Select(started, zero, dx);
+            }
+
+            xx = Ops::Select(started, zero, xx);
+            yy = Ops::Select(started, zero, yy);
+            iteration = Ops::Select(started, zero, iteration);
+            dy = Ops::Select(started, zero, dy);
+            period = Ops::Select(started, zero, period);
+
+            if (interior) {
+                savedX = Ops::Select(started, x, savedX);
+                savedY = Ops::Select(started, y, savedY);
+                savedAt = Ops::Select(started, zero, savedAt);
+                nextSave = Ops::Select(started, one, nextSave);
+
+                if (!julia) {
+                    // Main cardioid and the period 2 bulb
+                    const auto quarter = Ops::Set(0.25f);
+                    const auto qx = Ops::Sub(cx, quarter);
+                    const auto q = Ops::Add(Ops::Mul(qx, qx), Ops::Mul(cy, cy));
+                    const auto cardioid = Ops::LessEqual(Ops::Mul(q, Ops::Add(q, qx)), Ops::Mul(quarter, Ops::Mul(cy, cy)));
+                    const auto bx = Ops::Add(cx, one);
+                    const auto bulb = Ops::LessEqual(Ops::Add(Ops::Mul(bx, bx), Ops::Mul(cy, cy)), Ops::Set(0.0625f));
+
+                    period = Ops::Select(Ops::And(started, bulb), two, period);
+                    period = Ops::Select(Ops::And(started, cardioid), one, period);
+                }
+            }
+
+            // New pixels can be done before the first iteration, like in the cardioid
+            continue;
+        }
+
+        steps++;
+
+        const auto nxx = Ops::Mul(x, x);
+        const auto nyy = Ops::Mul(y, y);
+        const auto nx = Ops::Add(Ops::Sub(nxx, nyy), cx);
+        const auto ny = Ops::Add(Ops::Mul(Ops::Mul(two, x), y), cy);
+
+        if (julia) {
+            const auto term = Exp<Ops>(Ops::Sub(zero, Length<Ops>(nx, ny)));
+            sum = Ops::Select(active, Ops::Add(sum, term), sum);
+        }
+
+        if (distance) {
+            // dz' = 2 z dz, plus 1 for Mandelbrot
+            auto ndx = Ops::Mul(two, Ops::Sub(Ops::Mul(x, dx), Ops::Mul(y, dy)));
+            const auto ndy = Ops::Mul(two, Ops::Add(Ops::Mul(x, dy), Ops::Mul(y, dx)));
+
+            if (!julia) {
+                ndx = Ops::Add(ndx, one);
+            }
+
+            dx = Ops::Select(active, ndx, dx);
+            dy = Ops::Select(active, ndy, dy);
+        }
+
+        xx = Ops::Select(active, nxx, xx);
+        yy = Ops::Select(active, nyy, yy);
+        x = Ops::Select(active, nx, x);
+        y = Ops::Select(active, ny, y);
+        iteration = Ops::Add(iteration, Ops::Select(active, one, zero));
+
+        if (interior) {
+            // CycleDetector::Step with the schedule of each lane
+            const auto ex = Ops::Sub(x, savedX);
+            const auto ey = Ops::Sub(y, savedY);
+            const auto found = Ops::And(active, Ops::LessEqual(Ops::Add(Ops::Mul(ex, ex), Ops::Mul(ey, ey)), epsilon));
+
+            period = Ops::Select(found, Ops::Sub(iteration, savedAt), period);
+
+            const auto save = Ops::And(active, Ops::LessEqual(nextSave, iteration));
+
+            savedX = Ops::Select(save, x, savedX);
+            savedY = Ops::Select(save, y, savedY);
+            savedAt = Ops::Select(save, iteration, savedAt);
+            nextSave = Ops::Select(save, Ops::Add(nextSave, nextSave), nextSave);
+        }
+    }
+
+    if (usage) {
+        usage->used += used;
+        usage->total += steps * lanes;
+    }
+}
+
+template <typename Ops, bool julia, bool refill>
+void Lanes(const float* x, const float* y, float* values, float* distances, const unsigned count, const KernelParams& params,
+    LaneUsage* usage)
+{
+    const bool interior = params.interiorEpsilon > 0.0;
+
+    if (distances) {
+        if (interior) {
+            LaneRow<Ops, julia, true, true, refill>(x, y, values, distances, count, params, usage);
+        } else {
+            LaneRow<Ops, julia, false, true, refill>(x, y, values, distances, count, params, usage);
+        }
+    } else if (interior) {
+        LaneRow<Ops, julia, true, false, refill>(x, y, values, distances, count, params, usage);
+    } else {
+        LaneRow<Ops, julia, false, false, refill>(x, y, values, distances, count, params, usage);
+    }
+}
+
+template <typename Ops>
+RowKernel GetKernel(const bool julia)
+{
+    return julia ? &Row<Ops, true> : &Row<Ops, false>;
+}
+
+template <typename Ops>
+OrbitKernel GetOrbitKernel(const bool julia)
+{
+    return julia ? &OrbitRow<Ops, true> : &OrbitRow<Ops, false>;
+}
+
+template <typename Ops>
+LaneKernel GetLaneKernel(const bool julia, const bool refill)
+{
+    if (julia) {
+        return refill ? &Lanes<Ops, true, true> : &Lanes<Ops, true, false>;
+    }
+
+    return refill ? &Lanes<Ops, false, true> : &Lanes<Ops, false, false>;
+}
+
+
+template <typename Ops>
+RowKernel GetChunkKernel(const bool julia, const unsigned block)
+{
+    switch (block) {
+        case 1:
+            return julia ? &ChunkRow<Ops, true, 1> : &ChunkRow<Ops, false, 1>;
+        case 4:
+            return julia ? &ChunkRow<Ops, true, 4> : &ChunkRow<Ops, false, 4>;
+        case 8:
+            return julia ? &ChunkRow<Ops, true, 8> : &ChunkRow<Ops, false, 8>;
+        case 12:
+            return julia ? &ChunkRow<Ops, true, 12> : &ChunkRow<Ops, false, 12>;
+        case 16:
+            return julia ? &ChunkRow<Ops, true, 16> : &ChunkRow<Ops, false, 16>;
+    }
+
+    return nullptr;
+}
+
+} // simd
+} // fractalnova
@@ -0,0 +1,133 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SimdKernel.hpp"
+
+#if defined(__ARM_NEON)
+
+#include "SimdKernelImpl.hpp"
+
+#include <arm_neon.h>
+
+namespace fractalnova {
+namespace {
+
+struct NeonOps
+{
+    using Float = float32x4_t;
+    using Mask = uint32x4_t;
+
+    static constexpr unsigned lanes { 4 };
+
+    static Float Load(const float* p) { return vld1q_f32(p); }
+    static void Store(float* p, const Float a) { vst1q_f32(p, a); }
+    static Float Set(const float a) { return vdupq_n_f32(a); }
+    static Float Add(const Float a, const Float b) { return vaddq_f32(a, b); }
+    static Float Sub(const Float a, const Float b) { return vsubq_f32(a, b); }
+    static Float Mul(const Float a, const Float b) { return vmulq_f32(a, b); }
+    static Mask LessEqual(const Float a, const Float b) { return vcleq_f32(a, b); }
+    static Mask Less(const Float a, const Float b) { return vcltq_f32(a, b); }
+    static Mask Greater(const Float a, const Float b) { return vcgtq_f32(a, b); }
+    static Mask And(const Mask a, const Mask b) { return vandq_u32(a, b); }
+    static Float Select(const Mask m, const Float a, const Float b) { return vbslq_f32(m, a, b); }
+    static Float Truncate(const Float a) { return vcvtq_f32_s32(vcvtq_s32_f32(a)); }
+    static Float Pow2(const Float n) { return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23)); }
+
+#if defined(__aarch64__)
+    static Float Sqrt(const Float a) { return vsqrtq_f32(a); }
+    static bool Any(const Mask m) { return vmaxvq_u32(m) != 0; }
+    static bool All(const Mask m) { return vminvq_u32(m) != 0; }
+#else
+    static Float Sqrt(const Float a)
+    {
+        // ARMv7 NEON has no exact square root
+        float t[lanes];
+        vst1q_f32(t, a);
+        for (auto& v: t) {
+            v = std::sqrt(v);
+        }
+        return vld1q_f32(t);
+    }
+
+    static bool Any(const Mask m)
+    {
+        const uint32x2_t r = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+        return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+    }
+
+    static bool All(const Mask m)
+    {
+        const uint32x2_t r = vand_u32(vget_low_u32(m), vget_high_u32(m));
+        return (vget_lane_u32(r, 0) & vget_lane_u32(r, 1)) != 0;
+    }
+#endif
+};
+
+} // anonymous
+
+RowKernel GetNeonKernel(const bool julia)
+{
+    return simd::GetKernel<NeonOps>(julia);
+}
+
+OrbitKernel GetNeonOrbitKernel(const bool julia)
+{
+    return simd::GetOrbitKernel<NeonOps>(julia);
+}
+
+LaneKernel GetNeonLaneKernel(const bool julia, const bool refill)
+{
+    return simd::GetLaneKernel<NeonOps>(julia, refill);
+}
+
+RowKernel GetNeonChunkKernel(const bool julia, const unsigned block)
+{
+    return simd::GetChunkKernel<NeonOps>(julia, block);
+}
+
+} // fractalnova
+
+#else
+
+namespace fractalnova {
+
+RowKernel GetNeonKernel(bool)
+{
+    return nullptr;
+}
+
+OrbitKernel GetNeonOrbitKernel(bool)
+{
+    return nullptr;
+}
+
+LaneKernel GetNeonLaneKernel(bool, bool)
+{
+    return nullptr;
+}
+
+RowKernel GetNeonChunkKernel(bool, unsigned)
+{
+    return nullptr;
+}
+
+} // fractalnova
+
+#endif
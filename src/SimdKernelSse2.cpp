@@ -0,0 +1,107 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SimdKernel.hpp"
+
+#if defined(__SSE2__)
+
+#include "SimdKernelImpl.hpp"
+
+#include <emmintrin.h>
+
+namespace fractalnova {
+namespace {
+
+struct Sse2Ops
+{
+    using Float = __m128;
+    using Mask = __m128;
+
+    static constexpr unsigned lanes { 4 };
+
+    static Float Load(const float* p) { return _mm_loadu_ps(p); }
+    static void Store(float* p, const Float a) { _mm_storeu_ps(p, a); }
+    static Float Set(const float a) { return _mm_set1_ps(a); }
+    static Float Add(const Float a, const Float b) { return _mm_add_ps(a, b); }
+    static Float Sub(const Float a, const Float b) { return _mm_sub_ps(a, b); }
+    static Float Mul(const Float a, const Float b) { return _mm_mul_ps(a, b); }
+    static Float Sqrt(const Float a) { return _mm_sqrt_ps(a); }
+    static Mask LessEqual(const Float a, const Float b) { return _mm_cmple_ps(a, b); }
+    static Mask Less(const Float a, const Float b) { return _mm_cmplt_ps(a, b); }
+    static Mask Greater(const Float a, const Float b) { return _mm_cmpgt_ps(a, b); }
+    static Mask And(const Mask a, const Mask b) { return _mm_and_ps(a, b); }
+    static bool Any(const Mask m) { return _mm_movemask_ps(m) != 0; }
+    static bool All(const Mask m) { return _mm_movemask_ps(m) == 0xf; }
+    static Float Select(const Mask m, const Float a, const Float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static Float Truncate(const Float a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+    static Float Pow2(const Float n) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23)); }
+};
+
+} // anonymous
+
+RowKernel GetSse2Kernel(const bool julia)
+{
+    return simd::GetKernel<Sse2Ops>(julia);
+}
+
+OrbitKernel GetSse2OrbitKernel(const bool julia)
+{
+    return simd::GetOrbitKernel<Sse2Ops>(julia);
+}
+
+LaneKernel GetSse2LaneKernel(const bool julia, const bool refill)
+{
+    return simd::GetLaneKernel<Sse2Ops>(julia, refill);
+}
+
+RowKernel GetSse2ChunkKernel(const bool julia, const unsigned block)
+{
+    return simd::GetChunkKernel<Sse2Ops>(julia, block);
+}
+
+} // fractalnova
+
+#else
+
+namespace fractalnova {
+
+RowKernel GetSse2Kernel(bool)
+{
+    return nullptr;
+}
+
+OrbitKernel GetSse2OrbitKernel(bool)
+{
+    return nullptr;
+}
+
+LaneKernel GetSse2LaneKernel(bool, bool)
+{
+    return nullptr;
+}
+
+RowKernel GetSse2ChunkKernel(bool, unsigned)
+{
+    return nullptr;
+}
+
+} // fractalnova
+
+#endif
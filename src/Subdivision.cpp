@@ -0,0 +1,230 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Subdivision.hpp"
+#include "TileScheduler.hpp"
+
+namespace fractalnova {
+
+Subdivision::Subdivision(float* values, const std::uint32_t stride, const Evaluate& evaluate, const bool guard):
+    values(values),
+    stride(stride),
+    evaluate(evaluate),
+    guard(guard)
+{
+}
+
+float& Subdivision::Value(const std::uint32_t x, const std::uint32_t y) const
+{
+    return values[static_cast<std::size_t>(y) * stride + x];
+}
+
+void Subdivision::Add(const std::uint32_t x, const std::uint32_t y)
+{
+    pending.push_back(Pixel { x, y });
+}
+
+void Subdivision::Flush()
+{
+    if (!pending.empty()) {
+        evaluate(pending.data(), pending.size());
+        pending.clear();
+    }
+}
+
+std::size_t Subdivision::Render(const Tile& tile)
+{
+    if (tile.width == 0 || tile.height == 0) {
+        return 0;
+    }
+
+    const Rect whole { tile.x, tile.y, tile.x + tile.width - 1, tile.y + tile.height - 1, false };
+
+    for (std::uint32_t x = whole.x0; x <= whole.x1; x++) {
+        Add(x, whole.y0);
+
+        if (whole.y1 != whole.y0) {
+            Add(x, whole.y1);
+        }
+    }
+
+    for (std::uint32_t y = whole.y0 + 1; y < whole.y1; y++) {
+        Add(whole.x0, y);
+
+        if (whole.x1 != whole.x0) {
+            Add(whole.x1, y);
+        }
+    }
+
+    Flush();
+
+    filled = 0;
+
+    std::vector<Rect> level { whole };
+    std::vector<Rect> next;
+
+    while (!level.empty()) {
+        // Guard samples of all uniform rectangles of the level at once
+        for (Rect& r: level) {
+            r.candidate = r.x1 - r.x0 >= 2 && r.y1 - r.y0 >= 2 && Uniform(r);
+
+            if (r.candidate && guard) {
+                AddGuardSamples(r);
+            }
+        }
+
+        Flush();
+
+        for (const Rect& r: level) {
+            if (r.candidate && (!guard || GuardHolds(r))) {
+                Fill(r);
+            } else {
+                Split(r, next);
+            }
+        }
+
+        Flush();
+
+        level.swap(next);
+        next.clear();
+    }
+
+    return filled;
+}
+
+void Subdivision::Split(const Rect& r, std::vector<Rect>& next)
+{
+    if (r.x1 - r.x0 < 2 || r.y1 - r.y0 < 2) {
+        return;
+    }
+
+    const std::size_t inside = static_cast<std::size_t>(r.x1 - r.x0 - 1) * (r.y1 - r.y0 - 1);
+
+    if (inside <= minInside) {
+        for (std::uint32_t y = r.y0 + 1; y < r.y1; y++) {
+            for (std::uint32_t x = r.x0 + 1; x < r.x1; x++) {
+                Add(x, y);
+            }
+        }
+
+        return;
+    }
+
+    if (r.x1 - r.x0 >= r.y1 - r.y0) {
+        const std::uint32_t xm = r.x0 + (r.x1 - r.x0) / 2;
+
+        for (std::uint32_t y = r.y0 + 1; y < r.y1; y++) {
+            Add(xm, y);
+        }
+
+        next.push_back(Rect { r.x0, r.y0, xm, r.y1, false });
+        next.push_back(Rect { xm, r.y0, r.x1, r.y1, false });
+    } else {
+        const std::uint32_t ym = r.y0 + (r.y1 - r.y0) / 2;
+
+        for (std::uint32_t x = r.x0 + 1; x < r.x1; x++) {
+            Add(x, ym);
+        }
+
+        next.push_back(Rect { r.x0, r.y0, r.x1, ym, false });
+        next.push_back(Rect { r.x0, ym, r.x1, r.y1, false });
+    }
+}
+
+bool Subdivision::Uniform(const Rect& r) const
+{
+    const float value = Value(r.x0, r.y0);
+
+    // NaN never compares equal, so those borders are not uniform
+    for (std::uint32_t x = r.x0; x <= r.x1; x++) {
+        if (!(Value(x, r.y0) == value && Value(x, r.y1) == value)) {
+            return false;
+        }
+    }
+
+    for (std::uint32_t y = r.y0 + 1; y < r.y1; y++) {
+        if (!(Value(r.x0, y) == value && Value(r.x1, y) == value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Guard samples are every guardSpacing pixels inside (lo, hi), lined up with
+// the centre
+static std::uint32_t FirstSample(const std::uint32_t lo, const std::uint32_t hi, const std::uint32_t spacing)
+{
+    const std::uint32_t centre = lo + (hi - lo) / 2;
+
+    return centre - (centre - lo - 1) / spacing * spacing;
+}
+
+void Subdivision::AddGuardSamples(const Rect& r)
+{
+    const std::uint32_t firstX = FirstSample(r.x0, r.x1, guardSpacing);
+
+    for (std::uint32_t y = FirstSample(r.y0, r.y1, guardSpacing); y < r.y1; y += guardSpacing) {
+        for (std::uint32_t x = firstX; x < r.x1; x += guardSpacing) {
+            Add(x, y);
+        }
+    }
+}
+
+bool Subdivision::GuardHolds(const Rect& r) const
+{
+    const std::uint32_t firstX = FirstSample(r.x0, r.x1, guardSpacing);
+    const float value = Value(r.x0, r.y0);
+
+    for (std::uint32_t y = FirstSample(r.y0, r.y1, guardSpacing); y < r.y1; y += guardSpacing) {
+        for (std::uint32_t x = firstX; x < r.x1; x += guardSpacing) {
+            if (!(Value(x, y) == value)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void Subdivision::Fill(const Rect& r)
+{
+    const float value = Value(r.x0, r.y0);
+
+    for (std::uint32_t y = r.y0 + 1; y < r.y1; y++) {
+        for (std::uint32_t x = r.x0 + 1; x < r.x1; x++) {
+            Value(x, y) = value;
+        }
+    }
+
+    std::size_t count = static_cast<std::size_t>(r.x1 - r.x0 - 1) * (r.y1 - r.y0 - 1);
+
+    if (guard) {
+        // The guard samples were computed
+        const std::uint32_t samplesX = (r.x1 - FirstSample(r.x0, r.x1, guardSpacing) + guardSpacing - 1) / guardSpacing;
+        const std::uint32_t samplesY = (r.y1 - FirstSample(r.y0, r.y1, guardSpacing) + guardSpacing - 1) / guardSpacing;
+
+        count -= static_cast<std::size_t>(samplesX) * samplesY;
+    }
+
+    filled += count;
+}
+
+} // fractalnova
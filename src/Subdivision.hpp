@@ -0,0 +1,98 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace fractalnova {
+
+struct Tile;
+
+struct Pixel
+{
+    std::uint32_t x { 0 };
+    std::uint32_t y { 0 };
+};
+
+// Mariani-Silver subdivision of a tile. The border of a rectangle is computed
+// first, and when all of it has the same value the inside is filled with that
+// value. Otherwise the rectangle is split in two along its longer side and the
+// halves are handled the same way. Interior detection gives whole components
+// the same value, smooth colouring rarely does so elsewhere.
+//
+// The rectangles are processed a level at a time, so that the pixels of all
+// their split lines go to the kernel together and fill its lanes.
+class Subdivision
+{
+public:
+    // Computes the values of the pixels into the value buffer
+    using Evaluate = std::function<void(const Pixel* pixels, std::size_t count)>;
+
+    // The guard computes a sparse grid inside a uniform rectangle before filling
+    // it, which catches most details that do not reach the border
+    Subdivision(float* values, std::uint32_t stride, const Evaluate& evaluate, bool guard);
+
+    // Every pixel of the tile gets a value. Returns how many were filled
+    // instead of computed.
+    std::size_t Render(const Tile& tile);
+
+private:
+    // Inclusive bounds, the border is computed
+    struct Rect
+    {
+        std::uint32_t x0;
+        std::uint32_t y0;
+        std::uint32_t x1;
+        std::uint32_t y1;
+        // Border is uniform and the guard samples are pending
+        bool candidate;
+    };
+
+    bool Uniform(const Rect& r) const;
+    void AddGuardSamples(const Rect& r);
+    bool GuardHolds(const Rect& r) const;
+    void Fill(const Rect& r);
+    // Splits r and queues the split line, or the whole inside when it is small
+    void Split(const Rect& r, std::vector<Rect>& next);
+
+    void Add(std::uint32_t x, std::uint32_t y);
+    void Flush();
+
+    float& Value(std::uint32_t x, std::uint32_t y) const;
+
+    // Rectangles with fewer pixels inside are computed without looking further
+    static constexpr std::size_t minInside { 16 };
+    // Distance of the guard samples
+    static constexpr std::uint32_t guardSpacing { 8 };
+
+    float* values;
+    std::uint32_t stride;
+    const Evaluate& evaluate;
+    bool guard;
+
+    std::vector<Pixel> pending;
+    std::size_t filled { 0 };
+};
+
+} // fractalnova
@@ -0,0 +1,128 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "ThreadPool.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace fractalnova {
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    logging::Debug("Create ThreadPool with %u threads", threads);
+
+    // The caller of RunOnAll is thread 0
+    for (unsigned i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::Worker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+
+    wakeUp.notify_all();
+
+    for (auto& w: workers) {
+        w.join();
+    }
+}
+
+unsigned ThreadPool::Size() const
+{
+    return static_cast<unsigned>(workers.size()) + 1;
+}
+
+void ThreadPool::Worker(const unsigned thread)
+{
+    unsigned seenGeneration = 0;
+
+    while (true) {
+        const std::function<void(unsigned)>* job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [&] { return quit || generation != seenGeneration; });
+
+            if (quit) {
+                return;
+            }
+
+            seenGeneration = generation;
+            job = currentJob;
+        }
+
+        (*job)(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+
+        finished.notify_one();
+    }
+}
+
+void ThreadPool::RunOnAll(const std::function<void(unsigned thread)>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = &job;
+        busyWorkers = static_cast<unsigned>(workers.size());
+        generation++;
+    }
+
+    wakeUp.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return busyWorkers == 0; });
+
+    currentJob = nullptr;
+}
+
+void ThreadPool::ParallelFor(const unsigned count, const std::function<void(unsigned index)>& job)
+{
+    if (count == 0) {
+        return;
+    }
+
+    std::atomic<unsigned> nextIndex { 0 };
+
+    RunOnAll([&](unsigned) {
+        unsigned index;
+
+        while ((index = nextIndex.fetch_add(1)) < count) {
+            job(index);
+        }
+    });
+}
+
+} // fractalnova
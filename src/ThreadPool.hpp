@@ -0,0 +1,62 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fractalnova {
+
+class ThreadPool
+{
+public:
+    // 0 means one thread per hardware thread
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    unsigned Size() const;
+
+    // Call job(index) for every index in [0, count). The calling thread helps and
+    // the call returns when all jobs are done.
+    void ParallelFor(unsigned count, const std::function<void(unsigned index)>& job);
+
+    // Call job(thread) exactly once on every thread. The calling thread is thread 0.
+    void RunOnAll(const std::function<void(unsigned thread)>& job);
+
+private:
+    void Worker(unsigned thread);
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+
+    const std::function<void(unsigned)>* currentJob { nullptr };
+    unsigned busyWorkers { 0 };
+    unsigned generation { 0 };
+    bool quit { false };
+};
+
+} // fractalnova
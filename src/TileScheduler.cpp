@@ -0,0 +1,195 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "TileScheduler.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+
+namespace fractalnova {
+
+TileScheduler::TileScheduler(ThreadPool& pool, const std::uint32_t tileSize):
+    pool(pool),
+    timer(std::make_unique<Timer>()),
+    tileSize(tileSize)
+{
+    logging::Debug("Create TileScheduler, tile size %u", tileSize);
+
+    for (unsigned i = 0; i < pool.Size(); i++) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+}
+
+TileScheduler::~TileScheduler() = default;
+
+void TileScheduler::SetFocus(const double x, const double y)
+{
+    focusX = std::clamp(x, 0.0, 1.0);
+    focusY = std::clamp(y, 0.0, 1.0);
+}
+
+bool TileScheduler::Pop(const unsigned thread, unsigned& index)
+{
+    Queue& q = *queues[thread];
+    std::lock_guard<std::mutex> lock(q.mutex);
+
+    if (q.tiles.empty()) {
+        return false;
+    }
+
+    index = q.tiles.front();
+    q.tiles.pop_front();
+
+    return true;
+}
+
+bool TileScheduler::Steal(const unsigned thread, unsigned& index)
+{
+    const unsigned count = static_cast<unsigned>(queues.size());
+
+    // Start from the neighbour so that thieves spread out
+    for (unsigned i = 1; i < count; i++) {
+        Queue& q = *queues[(thread + i) % count];
+        std::lock_guard<std::mutex> lock(q.mutex);
+
+        if (!q.tiles.empty()) {
+            index = q.tiles.back();
+            q.tiles.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TileScheduler::Run(const std::uint32_t width, const std::uint32_t height, const std::function<void(const Tile& tile)>& job)
+{
+    const unsigned threads = static_cast<unsigned>(queues.size());
+
+    stats.tilesX = (width + tileSize - 1) / tileSize;
+    stats.tilesY = (height + tileSize - 1) / tileSize;
+
+    const unsigned tileCount = stats.tilesX * stats.tilesY;
+
+    stats.tileSeconds.assign(tileCount, 0.0);
+    stats.busySeconds.assign(threads, 0.0);
+    stats.tilesDone.assign(threads, 0);
+    stats.tilesStolen.assign(threads, 0);
+
+    // Nearest to the focus first, which is where a frame that is stopped
+    // early has its finished part
+    std::vector<unsigned> order(tileCount);
+    std::vector<double> distances(tileCount);
+
+    const double fx = focusX * static_cast<double>(width);
+    const double fy = focusY * static_cast<double>(height);
+
+    for (unsigned i = 0; i < tileCount; i++) {
+        const double cx = (static_cast<double>(i % stats.tilesX) + 0.5) * tileSize - fx;
+        const double cy = (static_cast<double>(i / stats.tilesX) + 0.5) * tileSize - fy;
+
+        order[i] = i;
+        distances[i] = cx * cx + cy * cy;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {
+        return distances[a] < distances[b];
+    });
+
+    for (unsigned t = 0; t < threads; t++) {
+        queues[t]->tiles.clear();
+    }
+
+    // Round robin, so that every thread starts next to the focus
+    for (unsigned i = 0; i < tileCount; i++) {
+        queues[i % threads]->tiles.push_back(order[i]);
+    }
+
+    const std::uint64_t start = timer->GetTicks();
+
+    pool.RunOnAll([&](const unsigned thread) {
+        unsigned index;
+
+        while (true) {
+            if (!Pop(thread, index)) {
+                if (!Steal(thread, index)) {
+                    break;
+                }
+
+                stats.tilesStolen[thread]++;
+            }
+
+            const std::uint32_t tx = index % stats.tilesX;
+            const std::uint32_t ty = index / stats.tilesX;
+
+            Tile tile;
+            tile.x = tx * tileSize;
+            tile.y = ty * tileSize;
+            tile.width = std::min(tileSize, width - tile.x);
+            tile.height = std::min(tileSize, height - tile.y);
+
+            const std::uint64_t tileStart = timer->GetTicks();
+
+            job(tile);
+
+            const double seconds = timer->TicksToSeconds(timer->GetTicks() - tileStart);
+
+            stats.tileSeconds[index] = seconds;
+            stats.busySeconds[thread] += seconds;
+            stats.tilesDone[thread]++;
+        }
+    });
+
+    stats.wallSeconds = timer->TicksToSeconds(timer->GetTicks() - start);
+}
+
+void TileScheduler::LogStats() const
+{
+    if (stats.tileSeconds.empty()) {
+        return;
+    }
+
+    std::vector<double> sorted = stats.tileSeconds;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto busy = std::minmax_element(stats.busySeconds.begin(), stats.busySeconds.end());
+
+    unsigned stolen = 0;
+    for (const unsigned s: stats.tilesStolen) {
+        stolen += s;
+    }
+
+    logging::Debug("Tiles %u * %u: cost min %.3f ms, median %.3f ms, max %.3f ms",
+                   stats.tilesX, stats.tilesY,
+                   sorted.front() * 1000.0, sorted[sorted.size() / 2] * 1000.0, sorted.back() * 1000.0);
+
+    logging::Debug("Threads %zu: busy min %.3f ms, max %.3f ms, wall %.3f ms, stolen tiles %u",
+                   stats.busySeconds.size(), *busy.first * 1000.0, *busy.second * 1000.0,
+                   stats.wallSeconds * 1000.0, stolen);
+
+    for (std::size_t t = 0; t < stats.busySeconds.size(); t++) {
+        logging::Detail("Thread %zu: %u tiles (%u stolen), busy %.3f ms",
+                        t, stats.tilesDone[t], stats.tilesStolen[t], stats.busySeconds[t] * 1000.0);
+    }
+}
+
+} // fractalnova
@@ -0,0 +1,101 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fractalnova {
+
+class ThreadPool;
+class Timer;
+
+struct Tile
+{
+    std::uint32_t x { 0 };
+    std::uint32_t y { 0 };
+    std::uint32_t width { 0 };
+    std::uint32_t height { 0 };
+};
+
+struct TileStats
+{
+    std::uint32_t tilesX { 0 };
+    std::uint32_t tilesY { 0 };
+
+    // Row-major, one entry per tile
+    std::vector<double> tileSeconds;
+
+    // One entry per thread
+    std::vector<double> busySeconds;
+    std::vector<unsigned> tilesDone;
+    std::vector<unsigned> tilesStolen;
+
+    double wallSeconds { 0.0 };
+};
+
+// Splits the frame into tiles and runs them on the thread pool. The tiles are
+// dealt out to the deques of the threads nearest to the focus first, and a
+// thread that runs out steals the farthest tile of another, so the cheap
+// outside tiles do not leave threads idle while others are stuck with the
+// interior.
+class TileScheduler
+{
+public:
+    static constexpr std::uint32_t defaultTileSize { 32 };
+
+    explicit TileScheduler(ThreadPool& pool, std::uint32_t tileSize = defaultTileSize);
+    ~TileScheduler();
+
+    void Run(std::uint32_t width, std::uint32_t height, const std::function<void(const Tile& tile)>& job);
+
+    // Position in fractions of the frame where the user looks, the centre by
+    // default. Its tiles are computed first.
+    void SetFocus(double x, double y);
+
+    const TileStats& Stats() const { return stats; }
+    void LogStats() const;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<unsigned> tiles;
+    };
+
+    bool Pop(unsigned thread, unsigned& index);
+    bool Steal(unsigned thread, unsigned& index);
+
+    ThreadPool& pool;
+    std::unique_ptr<Timer> timer;
+    std::uint32_t tileSize { defaultTileSize };
+    double focusX { 0.5 };
+    double focusY { 0.5 };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    TileStats stats;
+};
+
+} // fractalnova
@@ -0,0 +1,157 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "TiledRenderer.hpp"
+#include "CpuRenderer.hpp"
+#include "FrameBuffer.hpp"
+#include "ImageWriter.hpp"
+#include "Timer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace fractalnova {
+
+TiledRenderer::TiledRenderer(CpuRenderer& renderer, const std::uint32_t bandHeight):
+    renderer(renderer),
+    bandHeight(std::max(1u, bandHeight))
+{
+}
+
+TiledStats TiledRenderer::Render(const View& view, ImageWriter& writer, const std::uint32_t width, const std::uint32_t height)
+{
+    const std::uint32_t rows = std::min(bandHeight, height);
+
+    renderer.Resize(width, rows);
+
+    // The band waiting for or being written by the writer thread
+    auto spare = std::make_unique<FrameBuffer>(width, rows);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    const FrameBuffer* pending { nullptr };
+    std::uint32_t pendingRows { 0 };
+    bool done { false };
+    std::exception_ptr error;
+
+    Timer timer;
+    TiledStats stats;
+    stats.bufferBytes = 2 * static_cast<std::size_t>(width) * rows * sizeof(Color);
+
+    std::thread writerThread([&] {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true) {
+            changed.wait(lock, [&] { return pending || done; });
+
+            if (!pending) {
+                break;
+            }
+
+            const FrameBuffer* band = pending;
+            const std::uint32_t count = pendingRows;
+
+            lock.unlock();
+
+            const std::uint64_t start = timer.GetTicks();
+
+            try {
+                for (std::uint32_t y = 0; y < count; y++) {
+                    writer.WriteRow(band->Row(y));
+                }
+            } catch (...) {
+                lock.lock();
+                error = std::current_exception();
+                lock.unlock();
+            }
+
+            const double seconds = timer.TicksToSeconds(timer.GetTicks() - start);
+
+            lock.lock();
+            stats.writeSeconds += seconds;
+            pending = nullptr;
+            changed.notify_all();
+        }
+    });
+
+    const auto finish = [&] {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return !pending; });
+            done = true;
+        }
+
+        changed.notify_all();
+        writerThread.join();
+        renderer.SetBand(Band {});
+    };
+
+    const std::uint64_t start = timer.GetTicks();
+
+    try {
+        for (std::uint32_t top = 0; top < height; top += rows) {
+            const std::uint64_t renderStart = timer.GetTicks();
+
+            // The last band may reach past the image, those rows are not written
+            renderer.SetBand(Band { height, top });
+            renderer.Clear();
+            renderer.Render(view);
+
+            stats.renderSeconds += timer.TicksToSeconds(timer.GetTicks() - renderStart);
+            stats.bands++;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return !pending; });
+
+            if (error) {
+                break;
+            }
+
+            renderer.SwapFrame(spare);
+            pending = spare.get();
+            pendingRows = std::min(rows, height - top);
+            changed.notify_all();
+
+            logging::Detail("Band %u at row %u rendered", stats.bands, top);
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+
+    finish();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    stats.wallSeconds = timer.TicksToSeconds(timer.GetTicks() - start);
+    stats.pixels = static_cast<std::uint64_t>(width) * height;
+    stats.bytes = writer.BytesWritten();
+
+    return stats;
+}
+
+} // fractalnova
@@ -0,0 +1,66 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "TileScheduler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fractalnova {
+
+class CpuRenderer;
+class ImageWriter;
+struct View;
+
+struct TiledStats
+{
+    unsigned bands { 0 };
+    std::uint64_t pixels { 0 };
+    std::uint64_t bytes { 0 };
+    // Frame memory in use, independent of the image height
+    std::size_t bufferBytes { 0 };
+
+    double renderSeconds { 0.0 };
+    // Time the writer thread spent writing, overlapped with rendering
+    double writeSeconds { 0.0 };
+    double wallSeconds { 0.0 };
+};
+
+// Renders images of any height in bands of a few tile rows. The tiles of a band
+// are rendered in parallel and finish in any order, the band then goes to a
+// writer thread which streams its scanlines to the file in order while the next
+// band is rendered into a second buffer. Memory stays at two bands.
+class TiledRenderer
+{
+public:
+    static constexpr std::uint32_t defaultBandHeight { 2 * TileScheduler::defaultTileSize };
+
+    explicit TiledRenderer(CpuRenderer& renderer, std::uint32_t bandHeight = defaultBandHeight);
+
+    TiledStats Render(const View& view, ImageWriter& writer, std::uint32_t width, std::uint32_t height);
+
+private:
+    CpuRenderer& renderer;
+    std::uint32_t bandHeight;
+};
+
+} // fractalnova
@@ -21,13 +21,22 @@ freely, subject to the following restrictions:
 #include "Timer.hpp"
 #include "Logger.hpp"
 
+#ifdef __amigaos4__
 #include <proto/exec.h>
 #include <proto/timer.h>
+#else
+#include <chrono>
+#endif
 
 #include <stdexcept>
 
 namespace fractalnova {
 
+#ifdef __amigaos4__
+
+// ITimer is shared by all Timer instances
+static unsigned interfaceUsers { 0 };
+
 Timer::Timer()
 {
     logging::Debug("Create Timer");
@@ -74,13 +83,15 @@ Timer::Timer()
         }
     }
 
+    interfaceUsers++;
+
     EClockVal clockVal;
     frequency = ITimer->ReadEClock(&clockVal);
 }
 
 Timer::~Timer()
 {
-    if (ITimer) {
+    if (--interfaceUsers == 0 && ITimer) {
         IExec->DropInterface(reinterpret_cast<struct Interface *>(ITimer));
         ITimer = nullptr;
     }
@@ -121,14 +132,34 @@ struct MyClock {
     };
 };
 
-uint64 Timer::GetTicks() const
+std::uint64_t Timer::GetTicks() const
 {
     MyClock now;
     ITimer->ReadEClock(&now.clockVal);
     return now.ticks;
 }
 
-double Timer::TicksToSeconds(uint64 ticks) const
+#else
+
+using Clock = std::chrono::steady_clock;
+
+Timer::Timer()
+{
+    logging::Debug("Create Timer");
+
+    frequency = static_cast<double>(Clock::period::den) / static_cast<double>(Clock::period::num);
+}
+
+Timer::~Timer() = default;
+
+std::uint64_t Timer::GetTicks() const
+{
+    return static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+}
+
+#endif
+
+double Timer::TicksToSeconds(const std::uint64_t ticks) const
 {
     return static_cast<double>(ticks) / frequency;
 }
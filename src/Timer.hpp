@@ -20,8 +20,12 @@ freely, subject to the following restrictions:
 
 #pragma once
 
+#ifdef __amigaos4__
 #include <exec/types.h>
 #include <devices/timer.h>
+#endif
+
+#include <cstdint>
 
 namespace fractalnova {
 
@@ -32,10 +36,11 @@ public:
     Timer();
     ~Timer();
 
-    uint64 GetTicks() const;
-    double TicksToSeconds(uint64 ticks) const;
+    std::uint64_t GetTicks() const;
+    double TicksToSeconds(std::uint64_t ticks) const;
 
 private:
+#ifdef __amigaos4__
     void FreeIoRequest();
     void FreeMsgPort();
     void CloseDevice();
@@ -43,6 +48,7 @@ private:
     struct MsgPort* port { nullptr };
     struct TimeRequest* request { nullptr };
     BYTE device { -1 };
+#endif
     double frequency { 0.0 };
 };
 
@@ -32,6 +32,13 @@ namespace fractalnova {
 
 static constexpr int minIter { 100 };
 static constexpr int maxIter { 1000 };
+static constexpr int minThreads { 1 };
+static constexpr int maxThreads { 64 };
+static constexpr int minFrameBudget { 0 };
+static constexpr int maxFrameBudget { 1000 };
+static constexpr int minAccumulate { 2 };
+static constexpr int maxAccumulate { 256 };
+static constexpr int defaultAccumulate { 64 };
 
 static Resolution ParseResolution(const char* const str)
 {
@@ -109,6 +116,8 @@ Params ToolTypeReader::ReadToolTypes(const char* const filename)
             params.vsync = IIcon->FindToolType(object->do_ToolTypes, "VSYNC");
             params.fullscreen = IIcon->FindToolType(object->do_ToolTypes, "FULLSCREEN");
             params.lazyClear = IIcon->FindToolType(object->do_ToolTypes, "LAZYCLEAR");
+            params.cpu = IIcon->FindToolType(object->do_ToolTypes, "CPU");
+            params.interior = IIcon->FindToolType(object->do_ToolTypes, "INTERIOR");
 
             const char* const iterationsStr = IIcon->FindToolType(object->do_ToolTypes, "ITERATIONS");
             if (iterationsStr) {
@@ -116,6 +125,24 @@ Params ToolTypeReader::ReadToolTypes(const char* const filename)
                 params.iterations = std::clamp(iterations, minIter, maxIter);
             }
 
+            const char* const threadsStr = IIcon->FindToolType(object->do_ToolTypes, "THREADS");
+            if (threadsStr) {
+                const int threads = atoi(threadsStr);
+                params.threads = static_cast<unsigned>(std::clamp(threads, minThreads, maxThreads));
+            }
+
+            const char* const accumulateStr = IIcon->FindToolType(object->do_ToolTypes, "ACCUMULATE");
+            if (accumulateStr) {
+                const int accumulate = atoi(accumulateStr);
+                params.accumulate = static_cast<unsigned>(accumulate > 0 ? std::clamp(accumulate, minAccumulate, maxAccumulate) : defaultAccumulate);
+            }
+
+            const char* const frameBudgetStr = IIcon->FindToolType(object->do_ToolTypes, "FRAMEBUDGET");
+            if (frameBudgetStr) {
+                const int frameBudget = atoi(frameBudgetStr);
+                params.frameBudget = std::clamp(frameBudget, minFrameBudget, maxFrameBudget);
+            }
+
             const char* const logLevelStr = IIcon->FindToolType(object->do_ToolTypes, "LOGLEVEL");
             if (logLevelStr) {
                 logging::SetLevel(ConvertToLogLevel(logLevelStr));
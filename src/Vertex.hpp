@@ -28,6 +28,12 @@ struct Vertex
     float y { 0.0f };
 };
 
+struct Vertex64
+{
+    double x { 0.0 };
+    double y { 0.0 };
+};
+
 struct Vertex4
 {
     float x { 0.0f };
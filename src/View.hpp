@@ -0,0 +1,52 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "EFractal.hpp"
+#include "Vertex.hpp"
+#include "BigFloat.hpp"
+#include "FloatExp.hpp"
+#include "Params.hpp"
+
+namespace fractalnova {
+
+// Everything the shaders get through their uniforms. Zoom and point are kept
+// in extended precision so that the CPU renderer can go past float range.
+struct View
+{
+    EFractal fractal { EFractal::Mandelbrot };
+    Vertex complex {};
+    Vertex scale { 3.5f, 2.0f };
+    FloatExp zoom { 1.0 };
+    BigFloat pointX {};
+    BigFloat pointY {};
+    int iterations { 100 };
+
+    // What the vertex shader would get
+    float Zoom() const { return static_cast<float>(zoom.ToDouble()); }
+    Vertex Point() const { return { static_cast<float>(pointX.ToDouble()), static_cast<float>(pointY.ToDouble()) }; }
+};
+
+// Fractal, iterations, centre and zoom from the params. The centre is turned
+// into the quad position the shaders use, -centre / scale.
+View MakeView(const Params& params);
+
+} // fractalnova
@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Y4mWriter.hpp"
+#include "FrameBuffer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace fractalnova {
+
+static std::uint8_t ToByte(const float value)
+{
+    return static_cast<std::uint8_t>(std::clamp(std::lround(value), 0l, 255l));
+}
+
+Y4mWriter::Y4mWriter(const std::string& filename, const std::uint32_t width, const std::uint32_t height, const unsigned fps):
+    width(width),
+    height(height)
+{
+    if (width == 0 || height == 0 || (width | height) & 1) {
+        throw std::runtime_error("Y4M needs an even, non-zero frame size");
+    }
+
+    file = filename == "-" ? stdout : std::fopen(filename.c_str(), "wb");
+
+    if (!file) {
+        throw std::runtime_error("Failed to open " + filename);
+    }
+
+    logging::Debug("Write Y4M video of size %u * %u to %s", width, height, filename.c_str());
+
+    char header[96];
+    const int length = snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", width, height, fps);
+    WriteBytes(header, static_cast<std::size_t>(length));
+
+    luma.resize(static_cast<std::size_t>(width) * height);
+    chroma.resize(luma.size() / 2);
+}
+
+Y4mWriter::~Y4mWriter()
+{
+    if (file && file != stdout) {
+        std::fclose(file);
+    } else if (file) {
+        std::fflush(file);
+    }
+}
+
+void Y4mWriter::Write(const FrameBuffer& frame)
+{
+    if (frame.Width() != width || frame.Height() != height) {
+        throw std::runtime_error("Frame does not match the video");
+    }
+
+    const std::uint32_t halfWidth = width / 2;
+    const std::size_t planeSize = static_cast<std::size_t>(halfWidth) * (height / 2);
+
+    // Full range BT.601, chroma averaged over 2 * 2 pixels
+    for (std::uint32_t y = 0; y < height; y += 2) {
+        const Color* rows[2] { frame.Row(y), frame.Row(y + 1) };
+
+        for (std::uint32_t x = 0; x < width; x += 2) {
+            float r = 0.0f;
+            float g = 0.0f;
+            float b = 0.0f;
+
+            for (unsigned dy = 0; dy < 2; dy++) {
+                for (unsigned dx = 0; dx < 2; dx++) {
+                    const Color& c = rows[dy][x + dx];
+                    luma[static_cast<std::size_t>(y + dy) * width + x + dx] = ToByte(0.299f * c.r + 0.587f * c.g + 0.114f * c.b);
+                    r += c.r;
+                    g += c.g;
+                    b += c.b;
+                }
+            }
+
+            r *= 0.25f;
+            g *= 0.25f;
+            b *= 0.25f;
+
+            const std::size_t index = static_cast<std::size_t>(y / 2) * halfWidth + x / 2;
+            chroma[index] = ToByte(128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b);
+            chroma[planeSize + index] = ToByte(128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b);
+        }
+    }
+
+    static const char marker[] { "FRAME\n" };
+    WriteBytes(marker, sizeof(marker) - 1);
+    WriteBytes(luma.data(), luma.size());
+    WriteBytes(chroma.data(), chroma.size());
+}
+
+void Y4mWriter::WriteBytes(const void* data, const std::size_t size)
+{
+    if (std::fwrite(data, 1, size, file) != size) {
+        throw std::runtime_error("Failed to write video");
+    }
+
+    bytesWritten += size;
+}
+
+} // fractalnova
@@ -0,0 +1,60 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace fractalnova {
+
+class FrameBuffer;
+
+// Raw YUV4MPEG2 video stream with 4:2:0 chroma, which video encoders read
+// directly. Filename "-" writes to the standard output.
+class Y4mWriter
+{
+public:
+    Y4mWriter(const std::string& filename, std::uint32_t width, std::uint32_t height, unsigned fps);
+    ~Y4mWriter();
+
+    Y4mWriter(const Y4mWriter&) = delete;
+    Y4mWriter& operator=(const Y4mWriter&) = delete;
+
+    void Write(const FrameBuffer& frame);
+
+    std::uint64_t BytesWritten() const { return bytesWritten; }
+
+private:
+    void WriteBytes(const void* data, std::size_t size);
+
+    std::FILE* file { nullptr };
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t bytesWritten { 0 };
+
+    // Planes of one frame, the format stores them one after another
+    std::vector<std::uint8_t> luma;
+    std::vector<std::uint8_t> chroma;
+};
+
+} // fractalnova
@@ -0,0 +1,160 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "ZoomSequence.hpp"
+#include "CpuRenderer.hpp"
+#include "FrameBuffer.hpp"
+#include "View.hpp"
+#include "Timer.hpp"
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace fractalnova {
+
+// 2^log2, for zoom levels past the range of a double
+static FloatExp PowerOfTwo(const double log2)
+{
+    const double whole = std::floor(log2);
+    return FloatExp { std::exp2(log2 - whole), static_cast<std::int64_t>(whole) };
+}
+
+ZoomSequence::ZoomSequence(CpuRenderer& renderer, const std::uint32_t width, const std::uint32_t height):
+    renderer(renderer),
+    frame(std::make_unique<FrameBuffer>(width, height))
+{
+}
+
+ZoomSequence::~ZoomSequence() = default;
+
+ZoomStats ZoomSequence::Render(const View& view, const ZoomPath& path, const FrameSink& sink)
+{
+    if (path.step <= 1.0 || path.keyFactor < path.step) {
+        throw std::runtime_error("Zoom step must be above 1 and keyframes at least one step apart");
+    }
+
+    const double stepLog2 = std::log2(path.step);
+    const double keyLog2 = std::log2(path.keyFactor);
+    const double startLog2 = view.zoom.Log2();
+    const double totalLog2 = path.endZoom.Log2() - startLog2;
+
+    const unsigned frames = static_cast<unsigned>(std::max(0.0, std::floor(totalLog2 / stepLog2 + 1e-9))) + 1;
+
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const std::uint32_t keyWidth = static_cast<std::uint32_t>(std::ceil(width * path.keyFactor));
+    const std::uint32_t keyHeight = static_cast<std::uint32_t>(std::ceil(height * path.keyFactor));
+
+    renderer.Resize(keyWidth, keyHeight);
+
+    Timer timer;
+    ZoomStats stats;
+    stats.frames = frames;
+
+    View key = view;
+    int current = -1;
+
+    for (unsigned i = 0; i < frames; i++) {
+        const double frameLog2 = i * stepLog2;
+        const int index = static_cast<int>(std::floor(frameLog2 / keyLog2 + 1e-9));
+
+        if (index != current) {
+            const std::uint64_t start = timer.GetTicks();
+
+            key.zoom = PowerOfTwo(startLog2 + index * keyLog2);
+            renderer.Clear();
+            renderer.Render(key);
+
+            stats.renderSeconds += timer.TicksToSeconds(timer.GetTicks() - start);
+            stats.keyframes++;
+            stats.keyPixels += static_cast<std::uint64_t>(keyWidth) * keyHeight;
+            current = index;
+
+            logging::Debug("Keyframe %d at zoom %s", index, key.zoom.ToString().c_str());
+        }
+
+        const std::uint64_t start = timer.GetTicks();
+
+        Resample(renderer.Frame(), std::exp2(frameLog2 - current * keyLog2));
+
+        stats.resampleSeconds += timer.TicksToSeconds(timer.GetTicks() - start);
+        stats.framePixels += static_cast<std::uint64_t>(width) * height;
+
+        sink(i, *frame);
+    }
+
+    return stats;
+}
+
+// The frame is the keyframe magnified by scale around the centre, sampled bilinearly
+void ZoomSequence::Resample(const FrameBuffer& key, const double scale)
+{
+    const std::uint32_t width = frame->Width();
+    const std::uint32_t height = frame->Height();
+    const double keyWidth = static_cast<double>(key.Width());
+    const double keyHeight = static_cast<double>(key.Height());
+
+    const auto keyPosition = [scale](const std::uint32_t i, const double size, const double keySize) {
+        const double ndc = (2.0 * static_cast<double>(i) + 1.0) / size - 1.0;
+        const double k = ((ndc / scale + 1.0) * keySize - 1.0) * 0.5;
+        return std::clamp(k, 0.0, keySize - 1.0);
+    };
+
+    std::vector<std::uint32_t> x0(width);
+    std::vector<float> fx(width);
+
+    for (std::uint32_t x = 0; x < width; x++) {
+        const double k = keyPosition(x, static_cast<double>(width), keyWidth);
+        x0[x] = std::min(static_cast<std::uint32_t>(k), key.Width() - 2);
+        fx[x] = static_cast<float>(k - x0[x]);
+    }
+
+    for (std::uint32_t y = 0; y < height; y++) {
+        const double k = keyPosition(y, static_cast<double>(height), keyHeight);
+        const std::uint32_t y0 = std::min(static_cast<std::uint32_t>(k), key.Height() - 2);
+        const float fy = static_cast<float>(k - y0);
+
+        const Color* top = key.Row(y0);
+        const Color* bottom = key.Row(y0 + 1);
+        Color* out = frame->Row(y);
+
+        for (std::uint32_t x = 0; x < width; x++) {
+            const std::uint32_t i = x0[x];
+            const float wx = fx[x];
+
+            const auto mix = [&](const std::uint8_t a, const std::uint8_t b, const std::uint8_t c, const std::uint8_t d) {
+                const float upper = a + (b - a) * wx;
+                const float lower = c + (d - c) * wx;
+                return static_cast<std::uint8_t>(upper + (lower - upper) * fy + 0.5f);
+            };
+
+            out[x] = Color {
+                mix(top[i].r, top[i + 1].r, bottom[i].r, bottom[i + 1].r),
+                mix(top[i].g, top[i + 1].g, bottom[i].g, bottom[i + 1].g),
+                mix(top[i].b, top[i + 1].b, bottom[i].b, bottom[i + 1].b)
+            };
+        }
+    }
+}
+
+} // fractalnova
@@ -0,0 +1,78 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#pragma once
+
+#include "FloatExp.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace fractalnova {
+
+class CpuRenderer;
+class FrameBuffer;
+struct View;
+
+struct ZoomPath
+{
+    FloatExp endZoom { 1e6 };
+    // Zoom factor between frames, like one mouse wheel tick
+    double step { 1.01 };
+    // Zoom factor between keyframes, also their size relative to the frames
+    double keyFactor { 2.0 };
+};
+
+struct ZoomStats
+{
+    unsigned frames { 0 };
+    unsigned keyframes { 0 };
+    // Pixels of the keyframes against the pixels of every frame
+    std::uint64_t keyPixels { 0 };
+    std::uint64_t framePixels { 0 };
+
+    double renderSeconds { 0.0 };
+    double resampleSeconds { 0.0 };
+};
+
+// Zoom movie from the view zoom to the end zoom around the view point. Only
+// keyframes at exponentially spaced zoom levels are rendered, keyFactor times
+// larger than the frames, and the frames in between are cut out of the last
+// keyframe and resampled. Every frame then still has at least one keyframe
+// pixel per frame pixel.
+class ZoomSequence
+{
+public:
+    using FrameSink = std::function<void(unsigned index, const FrameBuffer& frame)>;
+
+    ZoomSequence(CpuRenderer& renderer, std::uint32_t width, std::uint32_t height);
+    ~ZoomSequence();
+
+    ZoomStats Render(const View& view, const ZoomPath& path, const FrameSink& sink);
+
+private:
+    void Resample(const FrameBuffer& key, double scale);
+
+    CpuRenderer& renderer;
+    std::unique_ptr<FrameBuffer> frame;
+};
+
+} // fractalnova
@@ -20,7 +20,10 @@ freely, subject to the following restrictions:
 
 #include "GuiWindow.hpp"
 #include "NovaContext.hpp"
+#include "CpuContext.hpp"
 #include "Timer.hpp"
+#include "FrameGovernor.hpp"
+#include "Profiler.hpp"
 #include "Logger.hpp"
 #include "Version.hpp"
 #include "StackChecker.hpp"
@@ -32,6 +35,7 @@ freely, subject to the following restrictions:
 
 #include <cstdio>
 #include <exception>
+#include <memory>
 
 namespace fractalnova {
 
@@ -54,6 +58,15 @@ static Params HandleWorkbench(WBStartup* startup)
     return reader.ReadToolTypes(args->wa_Name);
 }
 
+static std::unique_ptr<RenderContext> CreateContext(const GuiWindow& window, const Params& params)
+{
+    if (params.cpu) {
+        return std::make_unique<CpuContext>(window, params.iterations, params.threads, params.interior, params.accumulate);
+    }
+
+    return std::make_unique<NovaContext>(window, params.iterations);
+}
+
 static Params ReadParams(int argc, char* argv[])
 {
     if (argc > 0) {
@@ -77,18 +90,44 @@ int main(int argc, char* argv[])
 
     try {
         GuiWindow window { params };
-        NovaContext context { window, params.iterations };
+        auto context = CreateContext(window, params);
         Timer timer;
+        FrameGovernor governor { params.frameBudget / 1000.0, context->MaxResolutionDivisor() };
 
         const uint64 start = timer.GetTicks();
         uint64 eventTicks = start;
         uint64 fpsTicks = start;
         uint64 lastFrames = 0;
 
+        bool redraw { true };
+        bool updateTitle { false };
+
         while (true) {
+            // Frames are drawn only when something changed, or while the context
+            // refines the last one. Otherwise sleep until there is input.
+            const bool idle = !redraw && !context->Refining();
+
+            if (idle && governor.Interacting()) {
+                // Poll until the input has stopped long enough for full quality
+                if (governor.Restore(timer.TicksToSeconds(timer.GetTicks() - start))) {
+                    redraw = true;
+                    updateTitle = true;
+                } else {
+                    IDOS->Delay(1);
+                }
+            } else if (idle) {
+                window.WaitForInput();
+
+                // Time spent sleeping does not count towards the FPS
+                fpsTicks = timer.GetTicks();
+                lastFrames = frames;
+            }
+
             const uint64 now = timer.GetTicks();
+            // Refining stopped for this input, so it cannot wait
+            const bool interrupted = context->Refining() && window.InputPending();
 
-            if (timer.TicksToSeconds(now - eventTicks) >= eventPeriod) {
+            if (idle || interrupted || timer.TicksToSeconds(now - eventTicks) >= eventPeriod) {
                 if (!window.Run()) {
                     break;
                 }
@@ -97,38 +136,61 @@ int main(int argc, char* argv[])
                 events++;
 
                 if (window.Flagged(EFlag::Resize)) {
-                    context.Resize();
+                    context->Resize();
                 }
 
                 if (window.Flagged(EFlag::Reset)) {
-                    context.Reset();
+                    context->Reset();
                 }
 
-                context.UseProgram(window.GetFractal());
-                context.UsePalette(window.GetPalette());
-                context.SetZoom(window.GetZoom());
-                context.SetPosition(window.GetPosition());
-                context.SetIterations(window.GetIterations());
+                context->UseProgram(window.GetFractal());
+                context->UsePalette(window.GetPalette());
+                context->SetZoom(window.GetZoom());
+                context->SetPosition(window.GetPosition());
+
+                if (window.Flagged(EFlag::Redraw)) {
+                    governor.Interact(timer.TicksToSeconds(now - start));
+                    redraw = true;
+                }
             }
 
+            if (!redraw && !context->Refining()) {
+                continue;
+            }
+
+            redraw = false;
+
+            PROFILE_ZONE(EStage::Frame);
+
             const double passed = timer.TicksToSeconds(now - fpsTicks);
+            // Only the render and draw work, not the input handling before it
+            const uint64 frameStart = timer.GetTicks();
+
+            context->SetIterations(governor.Iterations(window.GetIterations()));
+            context->SetResolutionDivisor(governor.Divisor());
 
             if (!params.lazyClear || passed >= 1.0) {
-                context.Clear();
+                context->Clear();
             }
 
-            context.Draw();
-            context.SwapBuffers();
-            context.SetPosition({0.0f, 0.0f});
+            context->Draw();
+            context->SwapBuffers();
+            context->SetPosition({0.0, 0.0});
+
+            governor.Measure(timer.TicksToSeconds(timer.GetTicks() - frameStart), window.TakeVSyncWait());
 
             frames++;
 
-            if (passed >= 1.0) {
-                static char buffer[64];
-                snprintf(buffer, sizeof(buffer), "FPS %.2f, zoom %.1f", static_cast<double>(frames - lastFrames) / passed, window.GetZoom());
+            if (passed >= 1.0 || updateTitle) {
+                static char quality[64];
+                static char buffer[128];
+                governor.Describe(quality, sizeof(quality), window.GetIterations());
+                snprintf(buffer, sizeof(buffer), "FPS %.2f, zoom %.3g, %s", passed > 0.0 ? static_cast<double>(frames - lastFrames) / passed : 0.0,
+                    window.GetZoom(), quality);
                 window.SetTitle(buffer);
                 fpsTicks = now;
                 lastFrames = frames;
+                updateTitle = false;
             }
         }
 
@@ -139,6 +201,10 @@ int main(int argc, char* argv[])
         logging::Error("Exception: %s", e.what());
     }
 
+    if (profiler::Enabled()) {
+        profiler::Dump();
+    }
+
     //logging::Log("Frames %llu in %.1f second. FPS %.1f", frames, duration, frames / duration);
     //logging::Log("Events checked %llu. EPS %.1f", events, events / duration);
 
@@ -0,0 +1,1361 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "../src/SimdKernel.hpp"
+#include "../src/CpuRenderer.hpp"
+#include "../src/PrecisionKernel.hpp"
+#include "../src/TileScheduler.hpp"
+#include "../src/Fractal.hpp"
+#include "../src/FrameGovernor.hpp"
+#include "../src/Timer.hpp"
+#include "../src/FrameBuffer.hpp"
+#include "../src/Params.hpp"
+#include "../src/View.hpp"
+#include "../src/Logger.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace fractalnova;
+
+namespace {
+
+struct Grid
+{
+    std::vector<float> x;
+    std::vector<float> y;
+};
+
+// Texture coordinates of the reset view, like CpuRenderer at zoom 1
+Grid MakeGrid(const EFractal fractal, const unsigned width, const unsigned height)
+{
+    const FractalInfo info = GetFractalInfo(fractal);
+
+    Grid grid;
+
+    for (unsigned y = 0; y < height; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            const float ndcX = (2.0f * static_cast<float>(x) + 1.0f) / static_cast<float>(width) - 1.0f;
+            const float ndcY = (2.0f * static_cast<float>(y) + 1.0f) / static_cast<float>(height) - 1.0f;
+            grid.x.push_back(ndcX * info.scale.x);
+            grid.y.push_back(ndcY * info.scale.y);
+        }
+    }
+
+    return grid;
+}
+
+double RunKernel(const Timer& timer, const RowKernel kernel, const Grid& grid, std::vector<float>& values,
+                 const KernelParams& params, const unsigned width)
+{
+    const std::size_t count = grid.x.size();
+
+    const std::uint64_t start = timer.GetTicks();
+
+    for (std::size_t i = 0; i < count; i += width) {
+        kernel(&grid.x[i], &grid.y[i], &values[i], nullptr, width, params);
+    }
+
+    return timer.TicksToSeconds(timer.GetTicks() - start);
+}
+
+// Single threaded kernel throughput per ISA, checked bit by bit against the scalar kernel
+int KernelBenchmark()
+{
+    constexpr unsigned width { 512 };
+    constexpr unsigned height { 384 };
+    constexpr int iterationCounts[] { 100, 250, 500, 1000 };
+    constexpr EFractal fractals[] { EFractal::Mandelbrot, EFractal::Julia6 };
+
+    Timer timer;
+
+    printf("%-10s %-8s %6s %10s %8s %s\n", "fractal", "isa", "iter", "Mpix/s", "speedup", "bits");
+
+    int mismatches = 0;
+
+    for (const EFractal fractal: fractals) {
+        const bool julia = fractal != EFractal::Mandelbrot;
+        const Grid grid = MakeGrid(fractal, width, height);
+        const KernelParams base { 0, GetFractalInfo(fractal).complex };
+
+        for (const int iterations: iterationCounts) {
+            KernelParams params = base;
+            params.iterations = iterations;
+
+            std::vector<float> reference(grid.x.size());
+            const double scalarTime = RunKernel(timer, GetRowKernel(EIsa::Scalar, julia), grid, reference, params, width);
+
+            for (const EIsa isa: SupportedIsas()) {
+                std::vector<float> values(grid.x.size());
+                const double seconds = isa == EIsa::Scalar ?
+                    scalarTime : RunKernel(timer, GetRowKernel(isa, julia), grid, values, params, width);
+
+                const bool same = isa == EIsa::Scalar ||
+                    std::memcmp(values.data(), reference.data(), values.size() * sizeof(float)) == 0;
+
+                if (!same) {
+                    mismatches++;
+                }
+
+                printf("%-10s %-8s %6d %10.2f %7.2fx %s\n",
+                       GetFractalInfo(fractal).name, IsaName(isa), iterations,
+                       static_cast<double>(grid.x.size()) / seconds / 1e6,
+                       scalarTime / seconds,
+                       same ? "same" : "DIFFERENT");
+            }
+        }
+    }
+
+    return mismatches ? 1 : 0;
+}
+
+// Longest contiguous share if the tiles had been split evenly between the threads
+double StaticSplitSeconds(const TileStats& stats, const unsigned threads)
+{
+    const std::size_t count = stats.tileSeconds.size();
+    double worst = 0.0;
+
+    for (unsigned t = 0; t < threads; t++) {
+        double sum = 0.0;
+
+        for (std::size_t i = count * t / threads; i < count * (t + 1) / threads; i++) {
+            sum += stats.tileSeconds[i];
+        }
+
+        worst = std::max(worst, sum);
+    }
+
+    return worst;
+}
+
+// Scaling of the tile scheduler on a frame mixing the interior and the boundary
+int TileBenchmark(unsigned maxThreads)
+{
+    constexpr unsigned width { 1024 };
+    constexpr unsigned height { 768 };
+    constexpr int repeats { 3 };
+
+    if (maxThreads == 0) {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    View view;
+    view.iterations = 1000;
+    view.zoom = 2.0;
+    view.pointX = BigFloat { 0.15, BigFloat::defaultLimbs };
+
+    printf("%7s %10s %8s %10s %12s %10s %8s\n", "threads", "ms", "speedup", "efficiency", "static ms", "tile max/med", "stolen");
+
+    double single = 0.0;
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        CpuRenderer renderer { threads };
+        renderer.Resize(width, height);
+        renderer.UseReprojection(false);
+
+        double best = 1e9;
+        TileStats stats;
+
+        for (int r = 0; r < repeats; r++) {
+            renderer.Render(view);
+
+            const TileStats& s = renderer.Scheduler().Stats();
+
+            if (s.wallSeconds < best) {
+                best = s.wallSeconds;
+                stats = s;
+            }
+        }
+
+        if (threads == 1) {
+            single = best;
+        }
+
+        std::vector<double> sorted = stats.tileSeconds;
+        std::sort(sorted.begin(), sorted.end());
+
+        unsigned stolen = 0;
+        for (const unsigned s: stats.tilesStolen) {
+            stolen += s;
+        }
+
+        printf("%7u %10.2f %7.2fx %9.0f%% %12.2f %12.1f %8u\n",
+               threads, best * 1000.0, single / best, 100.0 * single / best / threads,
+               StaticSplitSeconds(stats, threads) * 1000.0,
+               sorted.back() / std::max(1e-9, sorted[sorted.size() / 2]),
+               stolen);
+    }
+
+    return 0;
+}
+
+struct DeepLocation
+{
+    const char* name;
+    EFractal fractal;
+    // Point of the view in quad units, -c / scale
+    const char* x;
+    const char* y;
+    const char* zoom;
+    int iterations;
+};
+
+constexpr DeepLocation deepLocations[] {
+    { "seahorse", EFractal::Mandelbrot, "0.212469682010616772786340430318506857", "-0.0659129521026559852465660281925695", "1e15", 5000 },
+    { "seahorse2", EFractal::Mandelbrot, "0.212469682010616772786340430318506857", "-0.0659129521026559852465660281925695", "1e30", 10000 },
+    { "misiurewicz", EFractal::Mandelbrot, "0", "-0.5", "1e30", 2000 },
+    { "extended", EFractal::Mandelbrot, "0", "-0.5", "1e400", 4000 },
+    { "julia", EFractal::Julia6, "0.36797176753563493", "-0.049249834580591505", "1e12", 1000 }
+};
+
+double RenderSeconds(const Timer& timer, CpuRenderer& renderer, const View& view)
+{
+    const std::uint64_t start = timer.GetTicks();
+    renderer.Render(view);
+    return timer.TicksToSeconds(timer.GetTicks() - start);
+}
+
+// Share of pixels where some channel differs by more than one step
+double DifferentPixels(const FrameBuffer& a, const FrameBuffer& b)
+{
+    const std::size_t count = static_cast<std::size_t>(a.Width()) * a.Height();
+    std::size_t different = 0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        const Color& p = a.Data()[i];
+        const Color& q = b.Data()[i];
+
+        if (std::abs(p.r - q.r) > 1 || std::abs(p.g - q.g) > 1 || std::abs(p.b - q.b) > 1) {
+            different++;
+        }
+    }
+
+    return static_cast<double>(different) / static_cast<double>(count);
+}
+
+// Perturbation with and without BLA iteration skipping
+int BlaBenchmark()
+{
+    constexpr unsigned width { 320 };
+    constexpr unsigned height { 240 };
+    // Allowed share of visibly different pixels
+    constexpr double tolerance { 0.001 };
+
+    Timer timer;
+
+    CpuRenderer plain;
+    CpuRenderer skipping;
+
+    plain.Resize(width, height);
+    skipping.Resize(width, height);
+    plain.UseBla(false);
+    // The default limits leave most of the locations to the fixed precision kernels
+    plain.UsePrecision(EPrecision::Perturbation);
+    skipping.UsePrecision(EPrecision::Perturbation);
+
+    printf("%-12s %6s %10s %10s %8s %10s %10s %9s\n", "location", "iter", "plain ms", "BLA ms", "speedup", "iter/pix", "skip/pix", "diff");
+
+    int failures = 0;
+
+    for (const DeepLocation& location: deepLocations) {
+        const FractalInfo info = GetFractalInfo(location.fractal);
+
+        View view;
+        view.fractal = location.fractal;
+        view.complex = info.complex;
+        view.scale = info.scale;
+        view.zoom = FloatExp::Parse(location.zoom);
+        view.iterations = location.iterations;
+
+        const unsigned limbs = BigFloat::LimbsForBits(static_cast<unsigned>(view.zoom.Log2()) + 64);
+        view.pointX = BigFloat::Parse(location.x, limbs);
+        view.pointY = BigFloat::Parse(location.y, limbs);
+
+        plain.Clear();
+        skipping.Clear();
+
+        const double plainSeconds = RenderSeconds(timer, plain, view);
+        const double blaSeconds = RenderSeconds(timer, skipping, view);
+
+        const PerturbationStats& stats = skipping.DeepStats();
+        const double pixels = static_cast<double>(std::max<std::uint64_t>(1, stats.pixels));
+        const double diff = DifferentPixels(plain.Frame(), skipping.Frame());
+
+        if (diff > tolerance) {
+            failures++;
+        }
+
+        printf("%-12s %6d %10.1f %10.1f %7.2fx %10.1f %10.1f %8.3f%%%s\n",
+               location.name, location.iterations, plainSeconds * 1000.0, blaSeconds * 1000.0, plainSeconds / blaSeconds,
+               static_cast<double>(stats.iterations) / pixels, static_cast<double>(stats.skipped) / pixels,
+               diff * 100.0, diff > tolerance ? " !" : "");
+    }
+
+    // A frame without perturbation after the deep ones has no deep stats
+    View shallow;
+    shallow.iterations = 1000;
+    skipping.UsePrecision(EPrecision::Float);
+    skipping.Render(shallow);
+
+    const PerturbationStats& after = skipping.DeepStats();
+    const bool stale = after.references || after.pixels || after.iterations || after.skipped || after.rebases || after.glitches;
+
+    if (stale) {
+        failures++;
+    }
+
+    printf("Deep stats after a Float frame: %s\n", stale ? "not cleared !" : "cleared");
+
+    return failures ? 1 : 0;
+}
+
+// Fixed precision kernels against perturbation over a range of zoom levels.
+// Shows where each precision stops matching and where it stops paying off,
+// for tuning PrecisionLimits.
+int PrecisionBenchmark()
+{
+    constexpr unsigned width { 160 };
+    constexpr unsigned height { 120 };
+    constexpr double tolerance { 0.001 };
+
+    constexpr EPrecision precisions[] {
+        EPrecision::Double, EPrecision::DoubleDouble, EPrecision::QuadDouble, EPrecision::Perturbation
+    };
+
+    constexpr const char* zooms[] { "1e4", "1e6", "1e8", "1e10", "1e12", "1e15", "1e20", "1e25", "1e30", "1e40", "1e50" };
+
+    Timer timer;
+
+    CpuRenderer truth;
+    CpuRenderer tested;
+
+    truth.Resize(width, height);
+    tested.Resize(width, height);
+    truth.UseBla(false);
+    truth.UsePrecision(EPrecision::Perturbation);
+
+    printf("%-8s", "zoom");
+
+    for (const EPrecision precision: precisions) {
+        printf(" %22s", PrecisionName(precision));
+    }
+
+    printf("  %s\n", "auto");
+
+    const FractalInfo info = GetFractalInfo(EFractal::Mandelbrot);
+
+    for (const char* zoom: zooms) {
+        View view;
+        view.fractal = EFractal::Mandelbrot;
+        view.complex = info.complex;
+        view.scale = info.scale;
+        view.zoom = FloatExp::Parse(zoom);
+        view.iterations = 1000;
+
+        const unsigned limbs = BigFloat::LimbsForBits(static_cast<unsigned>(view.zoom.Log2()) + 64);
+        // Misiurewicz point with detail at every depth. Unlike c = i its orbit
+        // is not exactly representable, which would flatter the fixed kernels.
+        view.pointX = BigFloat::Parse("0.028884675384463474578795841639606447275372983664643852536266050760223097354420", limbs);
+        view.pointY = BigFloat::Parse("-0.47814325540457075038554802886498871790491666825526458501715716075026232953285", limbs);
+
+        truth.Clear();
+        RenderSeconds(timer, truth, view);
+
+        printf("%-8s", zoom);
+
+        for (const EPrecision precision: precisions) {
+            tested.UsePrecision(precision);
+            tested.Clear();
+
+            const double seconds = RenderSeconds(timer, tested, view);
+            const double diff = DifferentPixels(truth.Frame(), tested.Frame());
+
+            printf(" %10.1f ms %7.3f%%%s", seconds * 1000.0, diff * 100.0, diff > tolerance ? "!" : " ");
+        }
+
+        tested.UsePrecision(EPrecision::Auto);
+        printf("  %s\n", PrecisionName(tested.SelectPrecision(view.zoom)));
+    }
+
+    return 0;
+}
+
+// Fixed corpus of the suite. Sizes and iterations stay put so that results
+// can be compared over time.
+struct SuiteLocation
+{
+    const char* name;
+    EFractal fractal;
+    // Centre on the complex plane, like "render --centre"
+    const char* x;
+    const char* y;
+    const char* zoom;
+    int iterations;
+    unsigned width;
+    unsigned height;
+};
+
+constexpr SuiteLocation suiteLocations[] {
+    { "full", EFractal::Mandelbrot, "0", "0", "1", 500, 320, 240 },
+    { "seahorse", EFractal::Mandelbrot, "-0.743643887037151", "0.131825904205330", "200", 500, 320, 240 },
+    { "elephant", EFractal::Mandelbrot, "0.28693186889504513", "0.014286693904085048", "100", 400, 320, 240 },
+    // Period 20 and 24 minibrots on the real axis next to the tip
+    { "minibrot", EFractal::Mandelbrot, "-1.9999999901843578354865371132225600898594146800305217273421840022611877285029045", "0", "5e19", 1000, 160, 120 },
+    { "minibrot-deep", EFractal::Mandelbrot, "-1.9999999999027503327861402929210719997431931408051653654136297291328990871173290", "0", "3e23", 1000, 160, 120 },
+    // Misiurewicz point with detail at every depth
+    { "misiurewicz", EFractal::Mandelbrot, "-0.1010963638456221610257854457386225654638054428262534838769311776607808407404700",
+        "0.95628651080914150077109605772997743580983333651052917003431432150052465906570", "1e40", 1000, 160, 120 },
+    { "misiurewicz-deep", EFractal::Mandelbrot, "-0.1010963638456221610257854457386225654638054428262534838769311776607808407404700",
+        "0.95628651080914150077109605772997743580983333651052917003431432150052465906570", "1e60", 1000, 160, 120 },
+    { "julia1", EFractal::Julia1, "0", "0", "1", 300, 160, 120 },
+    { "julia2", EFractal::Julia2, "0", "0", "1", 300, 160, 120 },
+    { "julia3", EFractal::Julia3, "0", "0", "1", 300, 160, 120 },
+    { "julia4", EFractal::Julia4, "0", "0", "1", 300, 160, 120 },
+    { "julia5", EFractal::Julia5, "0", "0", "1", 300, 160, 120 },
+    { "julia6", EFractal::Julia6, "0", "0", "1", 300, 160, 120 },
+    { "julia7", EFractal::Julia7, "0", "0", "1", 300, 160, 120 },
+    { "julia8", EFractal::Julia8, "0", "0", "1", 300, 160, 120 },
+    { "julia9", EFractal::Julia9, "0", "0", "1", 300, 160, 120 },
+    { "julia10", EFractal::Julia10, "0", "0", "1", 300, 160, 120 }
+};
+
+struct SuiteOptions
+{
+    unsigned maxThreads { 0 };
+    unsigned frames { 5 };
+    std::string filter;
+    std::string engine;
+    std::string json;
+    std::string baseline;
+    // Slowdown against the baseline that counts as a regression
+    double tolerance { 0.05 };
+    bool interior { false };
+    bool subdivide { false };
+};
+
+struct SuiteResult
+{
+    std::string location;
+    std::string engine;
+    unsigned threads { 0 };
+    double meanMs { 0.0 };
+    double stddevMs { 0.0 };
+    double minMs { 0.0 };
+    double mpixels { 0.0 };
+    double giterations { 0.0 };
+    // Share of the pixels that subdivision filled
+    double filled { 0.0 };
+    std::string hash;
+};
+
+// FNV-1a of the pixels, for noticing when a change alters the image
+std::string FrameHash(const FrameBuffer& frame)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(frame.Data());
+    const std::size_t count = static_cast<std::size_t>(frame.BytesPerRow()) * frame.Height();
+
+    for (std::size_t i = 0; i < count; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+
+    char text[17];
+    snprintf(text, sizeof(text), "%016" PRIx64, hash);
+    return text;
+}
+
+// Engines that are accurate at this zoom with the default limits
+std::vector<EPrecision> SuiteEngines(const FloatExp& zoom)
+{
+    const PrecisionLimits limits;
+    std::vector<EPrecision> engines;
+
+    if (zoom <= FloatExp { limits.floatZoom }) {
+        engines.push_back(EPrecision::Float);
+    }
+
+    if (zoom <= FloatExp { limits.doubleZoom }) {
+        engines.push_back(EPrecision::Double);
+    }
+
+    if (zoom <= FloatExp { limits.doubleDoubleZoom }) {
+        engines.push_back(EPrecision::DoubleDouble);
+    }
+
+    if (zoom <= FloatExp { limits.quadDoubleZoom }) {
+        engines.push_back(EPrecision::QuadDouble);
+    }
+
+    engines.push_back(EPrecision::Perturbation);
+
+    return engines;
+}
+
+// Value of "key": in a line written by WriteSuiteJson()
+std::string JsonField(const std::string& line, const std::string& key)
+{
+    const std::string tag = "\"" + key + "\": ";
+    const std::size_t pos = line.find(tag);
+
+    if (pos == std::string::npos) {
+        return {};
+    }
+
+    std::size_t begin = pos + tag.size();
+
+    if (line[begin] == '"') {
+        begin++;
+        return line.substr(begin, line.find('"', begin) - begin);
+    }
+
+    return line.substr(begin, line.find_first_of(",}", begin) - begin);
+}
+
+void WriteSuiteJson(const std::string& filename, const std::vector<SuiteResult>& results)
+{
+    FILE* file = fopen(filename.c_str(), "w");
+
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", filename.c_str());
+        return;
+    }
+
+    // One result per line, which is all that ReadSuiteJson() expects
+    fprintf(file, "{\n  \"isa\": \"%s\",\n  \"results\": [\n", IsaName(BestIsa()));
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const SuiteResult& r = results[i];
+
+        fprintf(file, "    {\"location\": \"%s\", \"engine\": \"%s\", \"threads\": %u, \"mean_ms\": %.3f, \"stddev_ms\": %.3f, "
+            "\"min_ms\": %.3f, \"mpix_s\": %.3f, \"giter_s\": %.4f, \"filled\": %.4f, \"hash\": \"%s\"}%s\n",
+            r.location.c_str(), r.engine.c_str(), r.threads, r.meanMs, r.stddevMs, r.minMs, r.mpixels, r.giterations,
+            r.filled, r.hash.c_str(), i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+}
+
+std::vector<SuiteResult> ReadSuiteJson(const std::string& filename)
+{
+    std::ifstream file { filename };
+    std::vector<SuiteResult> results;
+    std::string line;
+
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", filename.c_str());
+    }
+
+    while (std::getline(file, line)) {
+        if (line.find("\"location\"") == std::string::npos) {
+            continue;
+        }
+
+        SuiteResult r;
+        r.location = JsonField(line, "location");
+        r.engine = JsonField(line, "engine");
+        r.threads = static_cast<unsigned>(atoi(JsonField(line, "threads").c_str()));
+        r.meanMs = atof(JsonField(line, "mean_ms").c_str());
+        r.stddevMs = atof(JsonField(line, "stddev_ms").c_str());
+        r.hash = JsonField(line, "hash");
+        results.push_back(r);
+    }
+
+    return results;
+}
+
+// Slower than the baseline by more than the tolerance and the noise of both runs
+int CompareSuite(const std::vector<SuiteResult>& results, const std::vector<SuiteResult>& baseline, const double tolerance)
+{
+    printf("\n%-18s %-14s %7s %10s %10s %8s\n", "location", "engine", "threads", "ms", "base ms", "change");
+
+    int regressions = 0;
+
+    for (const SuiteResult& r: results) {
+        const auto b = std::find_if(baseline.begin(), baseline.end(), [&r](const SuiteResult& o) {
+            return o.location == r.location && o.engine == r.engine && o.threads == r.threads;
+        });
+
+        if (b == baseline.end()) {
+            printf("%-18s %-14s %7u %10.2f %10s\n", r.location.c_str(), r.engine.c_str(), r.threads, r.meanMs, "-");
+            continue;
+        }
+
+        const double change = r.meanMs / b->meanMs - 1.0;
+        const double noise = 2.0 * std::max(r.stddevMs, b->stddevMs);
+        const bool regressed = change > tolerance && r.meanMs - b->meanMs > noise;
+
+        if (regressed) {
+            regressions++;
+        }
+
+        printf("%-18s %-14s %7u %10.2f %10.2f %+7.1f%%%s%s\n", r.location.c_str(), r.engine.c_str(), r.threads, r.meanMs, b->meanMs,
+            change * 100.0, regressed ? " slower" : "", r.hash != b->hash ? " image differs" : "");
+    }
+
+    printf("%d regressions over %.0f%%\n", regressions, tolerance * 100.0);
+
+    return regressions ? 1 : 0;
+}
+
+// Frame time, throughput and image hash of every location, engine and thread
+// count, optionally saved as JSON and compared with an earlier run
+int SuiteBenchmark(const SuiteOptions& options)
+{
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned maxThreads = options.maxThreads ? options.maxThreads : hardware;
+
+    std::vector<unsigned> threadCounts;
+
+    for (unsigned t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+
+    threadCounts.push_back(maxThreads);
+
+    Timer timer;
+    std::vector<SuiteResult> results;
+
+    printf("%-18s %-14s %7s %10s %8s %10s %9s %9s %7s %s\n", "location", "engine", "threads", "ms", "stddev", "min ms", "Mpix/s", "Giter/s",
+        "filled", "hash");
+
+    for (const SuiteLocation& location: suiteLocations) {
+        if (!options.filter.empty() && options.filter != location.name) {
+            continue;
+        }
+
+        Params params;
+        params.fractal = location.fractal;
+        params.iterations = location.iterations;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+
+        const View view = MakeView(params);
+        const double pixels = static_cast<double>(location.width) * location.height;
+
+        // The work of the frame in escape-time iterations, counted once without
+        // any skipping so that it is the same for every engine
+        CpuRenderer counter;
+        counter.Resize(location.width, location.height);
+        counter.UseBla(false);
+        counter.UseReprojection(false);
+        counter.UsePrecision(EPrecision::Perturbation);
+        counter.Render(view);
+
+        const double iterations = static_cast<double>(counter.DeepStats().iterations);
+
+        for (const EPrecision engine: SuiteEngines(view.zoom)) {
+            if (!options.engine.empty() && options.engine != PrecisionName(engine)) {
+                continue;
+            }
+
+            for (const unsigned threads: threadCounts) {
+                CpuRenderer renderer { threads };
+                renderer.Resize(location.width, location.height);
+                renderer.UsePrecision(engine);
+                renderer.UseReprojection(false);
+                renderer.UseInteriorDetection(options.interior);
+                renderer.UseSubdivision(options.subdivide);
+
+                // Warm-up, which also builds the reference orbit of perturbation
+                renderer.Render(view);
+
+                std::vector<double> times;
+
+                for (unsigned f = 0; f < options.frames; f++) {
+                    times.push_back(RenderSeconds(timer, renderer, view) * 1000.0);
+                }
+
+                double mean = 0.0;
+                for (const double t: times) {
+                    mean += t;
+                }
+                mean /= static_cast<double>(times.size());
+
+                double variance = 0.0;
+                for (const double t: times) {
+                    variance += (t - mean) * (t - mean);
+                }
+                variance /= static_cast<double>(std::max<std::size_t>(1, times.size() - 1));
+
+                SuiteResult r;
+                r.location = location.name;
+                r.engine = PrecisionName(engine);
+                r.threads = threads;
+                r.meanMs = mean;
+                r.stddevMs = std::sqrt(variance);
+                r.minMs = *std::min_element(times.begin(), times.end());
+                r.mpixels = pixels / mean / 1000.0;
+                r.giterations = iterations / mean / 1e6;
+                r.filled = static_cast<double>(renderer.FilledPixels()) / pixels;
+                r.hash = FrameHash(renderer.Frame());
+
+                printf("%-18s %-14s %7u %10.2f %8.2f %10.2f %9.2f %9.3f %6.1f%% %s\n", r.location.c_str(), r.engine.c_str(), threads,
+                    r.meanMs, r.stddevMs, r.minMs, r.mpixels, r.giterations, r.filled * 100.0, r.hash.c_str());
+
+                results.push_back(r);
+            }
+        }
+    }
+
+    if (!options.json.empty()) {
+        WriteSuiteJson(options.json, results);
+    }
+
+    if (!options.baseline.empty()) {
+        return CompareSuite(results, ReadSuiteJson(options.baseline), options.tolerance);
+    }
+
+    return 0;
+}
+
+// Changing the iteration limit of a view, by continuing the orbits that stopped
+// at the last one against rendering it again. Rescaling the texture coordinates
+// of the escaped pixels can round a colour by one step, nothing more.
+int IterationsBenchmark()
+{
+    constexpr std::pair<int, int> changes[] { { 250, 1000 }, { 1000, 4000 }, { 4000, 250 } };
+
+    Timer timer;
+
+    printf("%-12s %6s %6s %10s %10s %8s %9s %9s\n", "location", "from", "to", "fresh ms", "resume ms", "speedup", "resumed", "diff");
+
+    int failures = 0;
+
+    for (const SuiteLocation& location: suiteLocations) {
+        Params params;
+        params.fractal = location.fractal;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+
+        View view = MakeView(params);
+
+        for (const auto& [from, to]: changes) {
+            CpuRenderer fresh;
+            CpuRenderer resumed;
+
+            if (fresh.SelectPrecision(view.zoom) != EPrecision::Float) {
+                break;
+            }
+
+            fresh.Resize(location.width, location.height);
+            resumed.Resize(location.width, location.height);
+            fresh.UseOrbitResume(false);
+
+            view.iterations = from;
+            resumed.Render(view);
+
+            view.iterations = to;
+            const double resumedSeconds = RenderSeconds(timer, resumed, view);
+            const double freshSeconds = RenderSeconds(timer, fresh, view);
+            const double diff = DifferentPixels(fresh.Frame(), resumed.Frame());
+
+            if (diff > 0.0) {
+                failures++;
+            }
+
+            const double pixels = static_cast<double>(location.width) * location.height;
+
+            printf("%-12s %6d %6d %10.2f %10.2f %7.2fx %8.1f%% %8.3f%%%s\n", location.name, from, to, freshSeconds * 1000.0,
+                resumedSeconds * 1000.0, freshSeconds / resumedSeconds, 100.0 * static_cast<double>(resumed.ResumedPixels()) / pixels,
+                diff * 100.0, diff > 0.0 ? " !" : "");
+        }
+    }
+
+    return failures ? 1 : 0;
+}
+
+// Progressive rendering of a new view: how soon the first pass shows it, what
+// all passes cost against one full frame, and how long it takes to show
+// something else when input arrives in the middle of the last pass
+int ProgressiveBenchmark()
+{
+    constexpr const char* names[] { "full", "seahorse", "elephant", "minibrot", "misiurewicz-deep", "julia3" };
+    constexpr std::uint32_t width { 640 };
+    constexpr std::uint32_t height { 480 };
+    // Pixels whose mirror image is deferred are computed instead of copied,
+    // which can differ on the boundary
+    constexpr double tolerance { 0.001 };
+
+    Timer timer;
+
+    printf("%-18s %10s %10s %7s %10s %7s %10s %9s\n", "location", "full ms", "first ms", "passes", "total ms", "ratio", "cancel ms",
+        "diff");
+
+    int failures = 0;
+
+    for (const SuiteLocation& location: suiteLocations) {
+        if (std::find_if(std::begin(names), std::end(names), [&](const char* name) { return std::strcmp(name, location.name) == 0; }) ==
+            std::end(names))
+        {
+            continue;
+        }
+
+        Params params;
+        params.fractal = location.fractal;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+        params.iterations = location.iterations;
+
+        const View view = MakeView(params);
+
+        CpuRenderer plain;
+        plain.Resize(width, height);
+        // The reference orbit is cached after the first frame
+        plain.Render(view);
+        plain.Clear();
+
+        const double fullSeconds = RenderSeconds(timer, plain, view);
+
+        CpuRenderer progressive;
+        progressive.Resize(width, height);
+        progressive.UseProgressive(true);
+        progressive.Render(view);
+        progressive.Clear();
+
+        const double firstSeconds = RenderSeconds(timer, progressive, view);
+        double totalSeconds = firstSeconds;
+        unsigned passes = 1;
+
+        while (progressive.ProvisionalPixels() > 0) {
+            totalSeconds += RenderSeconds(timer, progressive, view);
+            passes++;
+        }
+
+        const double diff = DifferentPixels(plain.Frame(), progressive.Frame());
+
+        // Input arrives a quarter of a frame into the last pass
+        CpuRenderer cancelled;
+        cancelled.Resize(width, height);
+        cancelled.UseProgressive(true);
+        cancelled.Render(view);
+        cancelled.Clear();
+
+        for (unsigned pass = 1; pass < passes; pass++) {
+            cancelled.Render(view);
+        }
+
+        const std::uint64_t start = timer.GetTicks();
+        const std::uint64_t trigger = start + static_cast<std::uint64_t>(fullSeconds / 4.0 / timer.TicksToSeconds(1));
+
+        cancelled.SetCancelCheck([&] { return timer.GetTicks() >= trigger; });
+        cancelled.Render(view);
+
+        const std::uint64_t end = timer.GetTicks();
+        const bool stopped = cancelled.Cancelled();
+
+        if (diff > tolerance) {
+            failures++;
+        }
+
+        char cancel[16] = "-";
+
+        if (stopped) {
+            snprintf(cancel, sizeof(cancel), "%.3f", timer.TicksToSeconds(end - trigger) * 1000.0);
+        }
+
+        printf("%-18s %10.2f %10.2f %7u %10.2f %6.2fx %10s %8.3f%%%s\n", location.name, fullSeconds * 1000.0, firstSeconds * 1000.0,
+            passes, totalSeconds * 1000.0, totalSeconds / fullSeconds, cancel, diff * 100.0, diff > tolerance ? " !" : "");
+    }
+
+    return failures ? 1 : 0;
+}
+
+// Root mean square difference of the colour channels
+double RmsDifference(const FrameBuffer& a, const FrameBuffer& b)
+{
+    const std::size_t count = static_cast<std::size_t>(a.Width()) * a.Height();
+    double sum = 0.0;
+
+    for (std::size_t i = 0; i < count; i++) {
+        const Color& p = a.Data()[i];
+        const Color& q = b.Data()[i];
+
+        const double r = p.r - q.r;
+        const double g = p.g - q.g;
+        const double bl = p.b - q.b;
+
+        sum += r * r + g * g + bl * bl;
+    }
+
+    return std::sqrt(sum / (3.0 * static_cast<double>(count)));
+}
+
+// Accumulating jittered samples of a still view: the time per sample and how
+// close 1, 4, 16 and 32 samples per pixel come to the image with 128
+int AccumulateBenchmark()
+{
+    constexpr unsigned steps[] { 1, 4, 16, 32 };
+    constexpr unsigned reference { 128 };
+    // Hundreds of frames of the slower locations would take minutes
+    constexpr double maxFrameSeconds { 0.25 };
+
+    Timer timer;
+
+    printf("%-12s %-14s %10s %10s", "location", "engine", "frame ms", "sample ms");
+
+    for (const unsigned step: steps) {
+        printf(" %7s%-3u", "rms@", step);
+    }
+
+    printf("\n");
+
+    for (const SuiteLocation& location: suiteLocations) {
+        Params params;
+        params.fractal = location.fractal;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+        params.iterations = location.iterations;
+
+        const View view = MakeView(params);
+
+        CpuRenderer accumulated;
+        accumulated.Resize(location.width, location.height);
+
+        // Perturbation has no sub-samples
+        if (accumulated.SelectPrecision(view.zoom) == EPrecision::Perturbation) {
+            continue;
+        }
+
+        const double frameSeconds = RenderSeconds(timer, accumulated, view);
+
+        if (frameSeconds > maxFrameSeconds) {
+            continue;
+        }
+
+        CpuRenderer truth;
+        truth.Resize(location.width, location.height);
+        truth.Render(view);
+
+        while (truth.AccumulatedSamples() < reference && truth.Accumulate()) {
+        }
+
+        printf("%-12s %-14s %10.2f", location.name, PrecisionName(accumulated.SelectPrecision(view.zoom)), frameSeconds * 1000.0);
+
+        double sampleSeconds = 0.0;
+        std::vector<double> rms;
+
+        for (const unsigned step: steps) {
+            const std::uint64_t start = timer.GetTicks();
+
+            while (accumulated.AccumulatedSamples() < step && accumulated.Accumulate()) {
+            }
+
+            sampleSeconds += timer.TicksToSeconds(timer.GetTicks() - start);
+            rms.push_back(RmsDifference(truth.Frame(), accumulated.Frame()));
+        }
+
+        printf(" %10.2f", sampleSeconds * 1000.0 / (steps[std::size(steps) - 1] - 1));
+
+        for (const double r: rms) {
+            printf(" %10.2f", r);
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
+
+// Texture coordinates of a view, computed like CpuRenderer does for float precision
+Grid MakeViewGrid(const View& view, const unsigned width, const unsigned height)
+{
+    const float zoom = view.Zoom();
+    const Vertex point = view.Point();
+    const float fw = static_cast<float>(width);
+    const float fh = static_cast<float>(height);
+
+    Grid grid;
+
+    for (unsigned y = 0; y < height; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            const float ndcX = (2.0f * static_cast<float>(x) + 1.0f) / fw - 1.0f;
+            const float ndcY = (2.0f * static_cast<float>(y) + 1.0f) / fh - 1.0f;
+            grid.x.push_back((ndcX / zoom - point.x) * view.scale.x);
+            grid.y.push_back((ndcY / zoom - point.y) * view.scale.y);
+        }
+    }
+
+    return grid;
+}
+
+// Runs a lane kernel over the grid in batches like the renderer
+double RunLaneKernel(const Timer& timer, const LaneKernel kernel, const Grid& grid, std::vector<float>& values,
+                     const KernelParams& params, LaneUsage& usage)
+{
+    constexpr unsigned batch { 256 };
+
+    const std::size_t count = grid.x.size();
+
+    usage = {};
+
+    const std::uint64_t start = timer.GetTicks();
+
+    for (std::size_t i = 0; i < count; i += batch) {
+        const unsigned n = static_cast<unsigned>(std::min<std::size_t>(batch, count - i));
+        kernel(&grid.x[i], &grid.y[i], &values[i], nullptr, n, params, &usage);
+    }
+
+    return timer.TicksToSeconds(timer.GetTicks() - start);
+}
+
+// Lane occupancy of the best ISA on the float locations, with and without
+// interior detection. The masked loop runs each vector until its slowest lane
+// escapes, refill gives a lane a new pixel as soon as its pixel is done. Times
+// are single threaded and best of three, the row kernel is what the renderer
+// uses. Values must be identical.
+int LanesBenchmark()
+{
+    constexpr int repeats { 3 };
+
+    const EIsa isa = BestIsa();
+
+    Timer timer;
+
+    printf("%-12s %-8s %6s %9s %10s %7s %10s %7s %s\n", "location", "interior", "iter", "row ms", "masked ms", "occ", "refill ms",
+        "occ", "bits");
+
+    int mismatches = 0;
+
+    LaneUsage maskedTotal;
+    LaneUsage refillTotal;
+
+    for (const SuiteLocation& location: suiteLocations) {
+        Params params;
+        params.fractal = location.fractal;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+        params.iterations = location.iterations;
+
+        const View view = MakeView(params);
+
+        if (CpuRenderer {}.SelectPrecision(view.zoom) != EPrecision::Float) {
+            continue;
+        }
+
+        const bool julia = location.fractal != EFractal::Mandelbrot;
+        const Grid grid = MakeViewGrid(view, location.width, location.height);
+        const double spacing = 2.0 * std::max(static_cast<double>(view.scale.x) / location.width,
+            static_cast<double>(view.scale.y) / location.height) / view.zoom.ToDouble();
+
+        for (const bool interior: { false, true }) {
+            const KernelParams kernelParams { view.iterations, view.complex, interior ? spacing / 8.0 : 0.0, spacing };
+
+            std::vector<float> reference(grid.x.size());
+            std::vector<float> masked(grid.x.size());
+            std::vector<float> refilled(grid.x.size());
+
+            LaneUsage maskedUsage;
+            LaneUsage refillUsage;
+
+            double rowSeconds = 1e9;
+            double maskedSeconds = 1e9;
+            double refillSeconds = 1e9;
+
+            for (int r = 0; r < repeats; r++) {
+                rowSeconds = std::min(rowSeconds, RunKernel(timer, GetRowKernel(isa, julia), grid, reference, kernelParams, location.width));
+                maskedSeconds = std::min(maskedSeconds, RunLaneKernel(timer, GetLaneKernel(isa, julia, false), grid, masked, kernelParams, maskedUsage));
+                refillSeconds = std::min(refillSeconds, RunLaneKernel(timer, GetLaneKernel(isa, julia, true), grid, refilled, kernelParams, refillUsage));
+            }
+
+            const std::size_t bytes = reference.size() * sizeof(float);
+            const bool same = std::memcmp(masked.data(), reference.data(), bytes) == 0 &&
+                std::memcmp(refilled.data(), reference.data(), bytes) == 0;
+
+            if (!same) {
+                mismatches++;
+            }
+
+            maskedTotal.used += maskedUsage.used;
+            maskedTotal.total += maskedUsage.total;
+            refillTotal.used += refillUsage.used;
+            refillTotal.total += refillUsage.total;
+
+            printf("%-12s %-8s %6d %9.2f %10.2f %6.1f%% %10.2f %6.1f%% %s\n", location.name, interior ? "yes" : "no", view.iterations,
+                rowSeconds * 1000.0, maskedSeconds * 1000.0, maskedUsage.Occupancy() * 100.0, refillSeconds * 1000.0,
+                refillUsage.Occupancy() * 100.0, same ? "same" : "DIFFERENT");
+        }
+    }
+
+    printf("%s, mean occupancy %.1f%% masked, %.1f%% refill\n", IsaName(isa), maskedTotal.Occupancy() * 100.0,
+        refillTotal.Occupancy() * 100.0);
+
+    return mismatches ? 1 : 0;
+}
+
+// Escape tests every 1 (the masked loop), 4, 8, 12 and 16 iterations with the
+// best ISA, single threaded and best of three. Times in ms, values must be
+// identical. Only the float locations, at several iteration limits.
+int ChunksBenchmark()
+{
+    constexpr int repeats { 3 };
+    constexpr int iterationCounts[] { 100, 250, 1000, 4000 };
+
+    const EIsa isa = BestIsa();
+
+    Timer timer;
+
+    printf("%s\n%-12s %6s", IsaName(isa), "location", "iter");
+
+    for (const unsigned block: chunkBlocks) {
+        printf(" %8u", block);
+    }
+
+    printf(" %8s %s\n", "speedup", "bits");
+
+    int mismatches = 0;
+
+    for (const SuiteLocation& location: suiteLocations) {
+        Params params;
+        params.fractal = location.fractal;
+        params.centreX = location.x;
+        params.centreY = location.y;
+        params.zoom = location.zoom;
+
+        View view = MakeView(params);
+
+        if (CpuRenderer {}.SelectPrecision(view.zoom) != EPrecision::Float) {
+            continue;
+        }
+
+        const bool julia = location.fractal != EFractal::Mandelbrot;
+        const Grid grid = MakeViewGrid(view, location.width, location.height);
+
+        for (const int iterations: iterationCounts) {
+            const KernelParams kernelParams { iterations, view.complex };
+
+            std::vector<float> reference;
+            double masked = 0.0;
+            double best = 1e9;
+            bool same = true;
+
+            printf("%-12s %6d", location.name, iterations);
+
+            for (const unsigned block: chunkBlocks) {
+                std::vector<float> values(grid.x.size());
+                double seconds = 1e9;
+
+                for (int r = 0; r < repeats; r++) {
+                    seconds = std::min(seconds, RunKernel(timer, GetChunkKernel(isa, julia, block), grid, values, kernelParams, location.width));
+                }
+
+                if (reference.empty()) {
+                    reference = values;
+                    masked = seconds;
+                } else if (std::memcmp(values.data(), reference.data(), values.size() * sizeof(float)) != 0) {
+                    same = false;
+                }
+
+                best = std::min(best, seconds);
+
+                printf(" %8.2f", seconds * 1000.0);
+            }
+
+            if (!same) {
+                mismatches++;
+            }
+
+            printf(" %7.2fx %s\n", masked / best, same ? "same" : "DIFFERENT");
+        }
+    }
+
+    return mismatches ? 1 : 0;
+}
+
+SuiteOptions ParseSuiteOptions(const int argc, char* argv[])
+{
+    SuiteOptions options;
+
+    for (int i = 2; i < argc; i++) {
+        const std::string arg = argv[i];
+
+        if (arg == "--interior") {
+            options.interior = true;
+            continue;
+        }
+
+        if (arg == "--subdivide") {
+            options.subdivide = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            break;
+        }
+
+        const char* value = argv[++i];
+
+        if (arg == "--threads") {
+            options.maxThreads = static_cast<unsigned>(atoi(value));
+        } else if (arg == "--frames") {
+            options.frames = std::max(1u, static_cast<unsigned>(atoi(value)));
+        } else if (arg == "--location") {
+            options.filter = value;
+        } else if (arg == "--engine") {
+            options.engine = value;
+        } else if (arg == "--json") {
+            options.json = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = atof(value) / 100.0;
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg.c_str());
+        }
+    }
+
+    return options;
+}
+
+// Frame governor decisions for simulated interactions. Frames that are slow only
+// because they wait for the vertical blank must keep full quality.
+int GovernorBenchmark()
+{
+    constexpr double budget { 0.016 };
+    constexpr unsigned maxDivisor { 4 };
+    constexpr int frames { 120 };
+    constexpr int iterations { 1000 };
+
+    struct Case
+    {
+        const char* name;
+        // Frame time and how much of it went to waiting for the display
+        double seconds;
+        double waited;
+        bool degrade;
+    };
+
+    constexpr Case cases[] {
+        { "vsync 60 Hz", 1.0 / 60.0, 1.0 / 60.0 - 0.004, false },
+        { "vsync 50 Hz", 1.0 / 50.0, 1.0 / 50.0 - 0.004, false },
+        { "no vsync", 0.004, 0.0, false },
+        { "slow", 0.040, 0.0, true },
+        { "slow vsync", 0.050, 0.010, true }
+    };
+
+    printf("%-12s %8s %8s %8s %10s\n", "case", "frame ms", "wait ms", "divisor", "iterations");
+
+    int failures = 0;
+
+    for (const Case& c: cases) {
+        FrameGovernor governor { budget, maxDivisor };
+
+        for (int f = 0; f < frames; f++) {
+            governor.Interact(f * c.seconds);
+            governor.Measure(c.seconds, c.waited);
+        }
+
+        const bool degraded = governor.Divisor() > 1 || governor.Iterations(iterations) < iterations;
+
+        if (degraded != c.degrade) {
+            failures++;
+        }
+
+        printf("%-12s %8.1f %8.1f %8u %10d%s\n", c.name, c.seconds * 1000.0, c.waited * 1000.0, governor.Divisor(),
+            governor.Iterations(iterations), degraded != c.degrade ? " !" : "");
+    }
+
+    return failures ? 1 : 0;
+}
+
+void Usage()
+{
+    printf("Usage: bench [kernels | tiles [max threads] | bla | precision | iterations | progressive | accumulate | lanes | chunks | governor | suite [options]]\n"
+           "Suite options:\n"
+           "  --threads N        largest thread count, powers of two up to it\n"
+           "  --frames N         timed frames per result, 5 by default\n"
+           "  --location NAME    only this location of the corpus\n"
+           "  --engine NAME      only this engine, for example Double-double\n"
+           "  --json FILE        save the results\n"
+           "  --baseline FILE    compare with saved results, fail on regressions\n"
+           "  --tolerance P      slowdown in percent that is a regression, 5 by default\n"
+           "  --interior         with interior detection\n"
+           "  --subdivide        with Mariani-Silver subdivision\n");
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+    const std::string mode = argc > 1 ? argv[1] : "kernels";
+
+    if (mode == "kernels") {
+        return KernelBenchmark();
+    }
+
+    if (mode == "tiles") {
+        return TileBenchmark(argc > 2 ? static_cast<unsigned>(atoi(argv[2])) : 0);
+    }
+
+    if (mode == "bla") {
+        return BlaBenchmark();
+    }
+
+    if (mode == "precision") {
+        return PrecisionBenchmark();
+    }
+
+    if (mode == "iterations") {
+        return IterationsBenchmark();
+    }
+
+    if (mode == "progressive") {
+        return ProgressiveBenchmark();
+    }
+
+    if (mode == "accumulate") {
+        return AccumulateBenchmark();
+    }
+
+    if (mode == "lanes") {
+        return LanesBenchmark();
+    }
+
+    if (mode == "chunks") {
+        return ChunksBenchmark();
+    }
+
+    if (mode == "governor") {
+        return GovernorBenchmark();
+    }
+
+    if (mode == "suite") {
+        return SuiteBenchmark(ParseSuiteOptions(argc, argv));
+    }
+
+    Usage();
+
+    return 1;
+}
@@ -0,0 +1,493 @@
+/*
+Copyright (C) 2020-2025 Juha Niemimaki
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be
+   misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "../src/CpuRenderer.hpp"
+#include "../src/PrecisionKernel.hpp"
+#include "../src/FrameBuffer.hpp"
+#include "../src/ImageWriter.hpp"
+#include "../src/TiledRenderer.hpp"
+#include "../src/ZoomSequence.hpp"
+#include "../src/Y4mWriter.hpp"
+#include "../src/Params.hpp"
+#include "../src/View.hpp"
+#include "../src/Timer.hpp"
+#include "../src/Profiler.hpp"
+#include "../src/Logger.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace fractalnova;
+
+namespace {
+
+// Larger images are rendered in bands
+constexpr std::uint64_t maxFramePixels { 4096 * 4096 };
+
+struct FractalName
+{
+    const char* name;
+    EFractal fractal;
+};
+
+constexpr FractalName fractalNames[] {
+    { "mandelbrot", EFractal::Mandelbrot },
+    { "julia1", EFractal::Julia1 },
+    { "julia2", EFractal::Julia2 },
+    { "julia3", EFractal::Julia3 },
+    { "julia4", EFractal::Julia4 },
+    { "julia5", EFractal::Julia5 },
+    { "julia6", EFractal::Julia6 },
+    { "julia7", EFractal::Julia7 },
+    { "julia8", EFractal::Julia8 },
+    { "julia9", EFractal::Julia9 },
+    { "julia10", EFractal::Julia10 }
+};
+
+struct PaletteName
+{
+    const char* name;
+    EPalette palette;
+};
+
+constexpr PaletteName paletteNames[] {
+    { "rainbow", EPalette::Rainbow },
+    { "rainbowrev", EPalette::RainbowRev },
+    { "red", EPalette::Red },
+    { "green", EPalette::Green },
+    { "blue", EPalette::Blue },
+    { "bw", EPalette::BlackAndWhite },
+    { "bwrev", EPalette::BlackAndWhiteRev }
+};
+
+struct PrecisionOption
+{
+    const char* name;
+    EPrecision precision;
+};
+
+constexpr PrecisionOption precisionNames[] {
+    { "auto", EPrecision::Auto },
+    { "float", EPrecision::Float },
+    { "double", EPrecision::Double },
+    { "dd", EPrecision::DoubleDouble },
+    { "qd", EPrecision::QuadDouble },
+    { "perturbation", EPrecision::Perturbation }
+};
+
+template <typename T, std::size_t N>
+auto Lookup(const T (&table)[N], const std::string& name, const char* what)
+{
+    for (const T& entry: table) {
+        if (name == entry.name) {
+            return entry;
+        }
+    }
+
+    throw std::runtime_error("Unknown " + std::string(what) + " '" + name + "'");
+}
+
+struct Options
+{
+    Params params;
+    EPrecision precision { EPrecision::Auto };
+    unsigned repeat { 1 };
+    bool tiled { false };
+    bool interior { false };
+    bool subdivide { false };
+    bool guard { true };
+    bool distance { false };
+    bool symmetry { true };
+    // Samples of the antialiased edge pixels
+    unsigned samples { 1 };
+    // Jittered samples of every pixel, like idle frames in the program
+    unsigned accumulate { 1 };
+    std::uint32_t bandHeight { TiledRenderer::defaultBandHeight };
+    // Zoom movie when the end zoom is set
+    std::string zoomEnd;
+    ZoomPath path;
+    unsigned fps { 30 };
+    std::string output;
+};
+
+Resolution ParseSize(const std::string& text)
+{
+    const std::size_t pos = text.find('x');
+
+    if (pos == std::string::npos) {
+        throw std::runtime_error("Size should be WIDTHxHEIGHT, got '" + text + "'");
+    }
+
+    Resolution r;
+    r.width = static_cast<std::uint32_t>(std::strtoul(text.substr(0, pos).c_str(), nullptr, 10));
+    r.height = static_cast<std::uint32_t>(std::strtoul(text.substr(pos + 1).c_str(), nullptr, 10));
+
+    if (r.width == 0 || r.height == 0) {
+        throw std::runtime_error("Invalid size '" + text + "'");
+    }
+
+    return r;
+}
+
+bool EndsWith(const std::string& text, const std::string& suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Zoom as given, when it is a positive finite number
+std::string ParseZoom(const std::string& text)
+{
+    const FloatExp zoom = FloatExp::Parse(text);
+
+    if (!std::isfinite(zoom.Mantissa()) || zoom.Mantissa() <= 0.0) {
+        throw std::runtime_error("Zoom should be a positive finite number, got '" + text + "'");
+    }
+
+    return text;
+}
+
+Options ParseOptions(const int argc, char* argv[])
+{
+    Options options;
+    Params& params = options.params;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+
+        if (arg.size() < 3 || arg.compare(0, 2, "--") != 0) {
+            if (!options.output.empty()) {
+                throw std::runtime_error("More than one output file");
+            }
+
+            options.output = arg;
+            continue;
+        }
+
+        if (arg == "--verbose") {
+            logging::SetLevel(logging::ELevel::Debug);
+            continue;
+        }
+
+        if (arg == "--tiled") {
+            options.tiled = true;
+            continue;
+        }
+
+        if (arg == "--interior") {
+            options.interior = true;
+            continue;
+        }
+
+        if (arg == "--subdivide") {
+            options.subdivide = true;
+            continue;
+        }
+
+        if (arg == "--no-guard") {
+            options.guard = false;
+            continue;
+        }
+
+        if (arg == "--distance") {
+            options.distance = true;
+            continue;
+        }
+
+        if (arg == "--no-symmetry") {
+            options.symmetry = false;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + arg);
+        }
+
+        const std::string value = argv[++i];
+
+        if (arg == "--fractal") {
+            params.fractal = Lookup(fractalNames, value, "fractal").fractal;
+        } else if (arg == "--palette") {
+            params.palette = Lookup(paletteNames, value, "palette").palette;
+        } else if (arg == "--precision") {
+            options.precision = Lookup(precisionNames, value, "precision").precision;
+        } else if (arg == "--iterations") {
+            params.iterations = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--centre") {
+            const std::size_t comma = value.find(',');
+
+            if (comma == std::string::npos) {
+                throw std::runtime_error("Centre should be X,Y, got '" + value + "'");
+            }
+
+            params.centreX = value.substr(0, comma);
+            params.centreY = value.substr(comma + 1);
+        } else if (arg == "--zoom") {
+            params.zoom = ParseZoom(value);
+        } else if (arg == "--size") {
+            params.windowSize = ParseSize(value);
+        } else if (arg == "--threads") {
+            params.threads = static_cast<unsigned>(std::max(0, std::atoi(value.c_str())));
+        } else if (arg == "--band") {
+            options.bandHeight = static_cast<std::uint32_t>(std::max(1, std::atoi(value.c_str())));
+            options.tiled = true;
+        } else if (arg == "--zoom-end") {
+            options.zoomEnd = ParseZoom(value);
+        } else if (arg == "--step") {
+            options.path.step = std::atof(value.c_str());
+        } else if (arg == "--key-factor") {
+            options.path.keyFactor = std::atof(value.c_str());
+        } else if (arg == "--fps") {
+            options.fps = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        } else if (arg == "--repeat") {
+            options.repeat = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        } else if (arg == "--aa") {
+            options.samples = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        } else if (arg == "--accumulate") {
+            options.accumulate = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        } else {
+            throw std::runtime_error("Unknown option " + arg);
+        }
+    }
+
+    if (options.output.empty()) {
+        throw std::runtime_error("No output file");
+    }
+
+    // Fail before rendering. Movies may go to a .y4m stream instead.
+    if (options.zoomEnd.empty() || (options.output != "-" && !EndsWith(options.output, ".y4m"))) {
+        ImageWriter::FormatFor(options.output);
+    }
+
+    return options;
+}
+
+int RenderMovie(Options& options, const View& view, CpuRenderer& renderer)
+{
+    const std::uint32_t width = options.params.windowSize.width;
+    const std::uint32_t height = options.params.windowSize.height;
+
+    options.path.endZoom = FloatExp::Parse(options.zoomEnd);
+
+    std::unique_ptr<Y4mWriter> video;
+
+    if (options.output == "-" || EndsWith(options.output, ".y4m")) {
+        video = std::make_unique<Y4mWriter>(options.output, width, height, options.fps);
+    } else if (options.output.find('%') == std::string::npos) {
+        throw std::runtime_error("Movie output needs a .y4m name or a frame number pattern");
+    }
+
+    Timer timer;
+    double writeSeconds = 0.0;
+    std::uint64_t bytes = 0;
+
+    ZoomSequence sequence { renderer, width, height };
+
+    const ZoomStats stats = sequence.Render(view, options.path, [&](const unsigned index, const FrameBuffer& frame) {
+        const std::uint64_t start = timer.GetTicks();
+
+        if (video) {
+            video->Write(frame);
+            bytes = video->BytesWritten();
+        } else {
+            char name[1024];
+            snprintf(name, sizeof(name), options.output.c_str(), index);
+
+            ImageWriter writer { name, ImageWriter::FormatFor(name), width, height };
+            writer.Write(frame);
+            writer.Finish();
+            bytes += writer.BytesWritten();
+        }
+
+        writeSeconds += timer.TicksToSeconds(timer.GetTicks() - start);
+    });
+
+    fprintf(stderr, "%u frames from %u keyframes: %.2fx fewer pixels than from scratch, render %.1f ms, resample %.2f ms, write %.2f ms per frame, %.1f MB\n",
+            stats.frames, stats.keyframes,
+            static_cast<double>(stats.framePixels) / static_cast<double>(std::max<std::uint64_t>(1, stats.keyPixels)),
+            stats.renderSeconds * 1000.0 / stats.frames, stats.resampleSeconds * 1000.0 / stats.frames,
+            writeSeconds * 1000.0 / stats.frames, static_cast<double>(bytes) / 1e6);
+
+    return 0;
+}
+
+void Usage()
+{
+    fprintf(stderr,
+            "Usage: render [options] <output.png | output.ppm | ->\n"
+            "  --fractal mandelbrot | julia1 ... julia10\n"
+            "  --palette rainbow | rainbowrev | red | green | blue | bw | bwrev\n"
+            "  --iterations N\n"
+            "  --centre X,Y       point of the complex plane, any number of digits\n"
+            "  --zoom Z           for example 1e100\n"
+            "  --size WxH\n"
+            "  --precision auto | float | double | dd | qd | perturbation\n"
+            "  --threads N        0 for one per core\n"
+            "  --interior         stop early inside the set and colour it by period\n"
+            "  --subdivide        fill rectangles with a uniform border\n"
+            "  --no-guard         fill them without checking inside first\n"
+            "  --distance         darken the colours towards the boundary of the set\n"
+            "  --aa N             up to N samples for pixels on edges, 16 for example\n"
+            "  --accumulate N     average N jittered samples of every pixel\n"
+            "  --no-symmetry      compute mirror images of the set instead of copying\n"
+            "  --repeat N         render N times and report the average\n"
+            "  --tiled            stream in bands, automatic for large images\n"
+            "  --band ROWS        band height of the tiled mode\n"
+            "  --zoom-end Z       zoom movie from --zoom to Z, output is a .y4m stream\n"
+            "                     or numbered images like frame%%05d.png\n"
+            "  --step S           zoom factor per movie frame, 1.01 by default\n"
+            "  --key-factor K     zoom factor between rendered keyframes, 2 by default\n"
+            "  --fps N            frame rate of the stream\n"
+            "  --verbose\n");
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    try {
+        options = ParseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        Usage();
+        return 1;
+    }
+
+    const Params& params = options.params;
+
+    // Keep the standard output clean for the image
+    if (options.output == "-") {
+        logging::SetLevel(logging::ELevel::Error);
+    }
+
+    // Stage times after the stats, when built with PROFILE=1
+    if (profiler::Enabled()) {
+        std::atexit(profiler::Dump);
+    }
+
+    try {
+        const View view = MakeView(params);
+        const std::uint32_t width = params.windowSize.width;
+        const std::uint32_t height = params.windowSize.height;
+
+        Timer timer;
+
+        CpuRenderer renderer { params.threads };
+        renderer.UsePalette(params.palette);
+        renderer.UsePrecision(options.precision);
+        renderer.UseInteriorDetection(options.interior);
+        renderer.UseSubdivision(options.subdivide);
+        renderer.UseSubdivisionGuard(options.guard);
+        renderer.UseDistanceEstimation(options.distance);
+        renderer.UseSupersampling(options.samples);
+        renderer.UseSymmetry(options.symmetry);
+
+        if (!options.zoomEnd.empty()) {
+            return RenderMovie(options, view, renderer);
+        }
+
+        if (options.tiled || static_cast<std::uint64_t>(width) * height > maxFramePixels) {
+            ImageWriter writer { options.output, ImageWriter::FormatFor(options.output), width, height };
+            TiledRenderer tiled { renderer, options.bandHeight };
+
+            const TiledStats stats = tiled.Render(view, writer, width, height);
+            writer.Finish();
+
+            fprintf(stderr, "%u * %u, %s, %u threads, %u bands: %.1f s, computed %.2f Mpix/s, wrote %.1f MB/s, buffers %.1f MB\n",
+                    width, height, PrecisionName(renderer.SelectPrecision(view.zoom)), renderer.Threads(), stats.bands,
+                    stats.wallSeconds, static_cast<double>(stats.pixels) / stats.renderSeconds / 1e6,
+                    static_cast<double>(stats.bytes) / std::max(1e-9, stats.writeSeconds) / 1e6,
+                    static_cast<double>(stats.bufferBytes) / 1e6);
+
+            return 0;
+        }
+
+        renderer.Resize(width, height);
+
+        double renderSeconds = 0.0;
+
+        for (unsigned i = 0; i < options.repeat; i++) {
+            const std::uint64_t start = timer.GetTicks();
+            renderer.Clear();
+            renderer.Render(view);
+            renderSeconds += timer.TicksToSeconds(timer.GetTicks() - start);
+        }
+
+        double accumulateSeconds = 0.0;
+
+        if (options.accumulate > 1) {
+            const std::uint64_t start = timer.GetTicks();
+
+            while (renderer.AccumulatedSamples() < options.accumulate && renderer.Accumulate()) {
+            }
+
+            accumulateSeconds = timer.TicksToSeconds(timer.GetTicks() - start);
+        }
+
+        const std::uint64_t start = timer.GetTicks();
+
+        ImageWriter writer { options.output, ImageWriter::FormatFor(options.output), width, height };
+        writer.Write(renderer.Frame());
+        writer.Finish();
+
+        const double writeSeconds = timer.TicksToSeconds(timer.GetTicks() - start);
+        const double frameSeconds = renderSeconds / options.repeat;
+
+        fprintf(stderr, "%u * %u, %s, %u threads: render %.1f ms (%.2f frames/s, %.2f Mpix/s), write %.1f ms\n",
+                width, height, PrecisionName(renderer.SelectPrecision(view.zoom)), renderer.Threads(),
+                frameSeconds * 1000.0, 1.0 / frameSeconds,
+                static_cast<double>(width) * height / frameSeconds / 1e6,
+                writeSeconds * 1000.0);
+
+        if (renderer.MirroredPixels() > 0) {
+            fprintf(stderr, "Mirrored %zu of %zu computed pixels\n", renderer.MirroredPixels(), renderer.ComputedPixels());
+        }
+
+        if (options.subdivide) {
+            fprintf(stderr, "Subdivision filled %zu of %zu computed pixels\n", renderer.FilledPixels(), renderer.ComputedPixels());
+        }
+
+        if (options.distance) {
+            fprintf(stderr, "%zu pixels need refinement\n", renderer.RefinementPixels());
+        }
+
+        if (options.samples > 1) {
+            fprintf(stderr, "Supersampled %zu pixels, %.1f %%\n", renderer.SupersampledPixels(),
+                    100.0 * static_cast<double>(renderer.SupersampledPixels()) / (static_cast<double>(width) * height));
+        }
+
+        if (options.accumulate > 1) {
+            fprintf(stderr, "Accumulated %u samples per pixel in %.1f ms\n", renderer.AccumulatedSamples(), accumulateSeconds * 1000.0);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+
+    return 0;
+}